@@ -14,21 +14,52 @@
 #include "main.h"
 
 #include "gpio.h"
+#include "gpio_event.h"
+#include "debounce.h"
+#include "timer_wheel.h"
 
-#include <cstdio>
+#include "Log.h"
+#include "Arena.h"
+#include "MemoryPool.h"
+#include "MemoryStats.h"
+#include "StackMonitor.h"
+#include "EventLoop.h"
 
 using namespace GPIO;
 
 // Global GPIO objects
 static GPIOOutput* led = nullptr;
-static GPIOEXTI* btn0 = nullptr;
-static GPIOEXTI* btn1 = nullptr; 
-static GPIOEXTI* btn2 = nullptr;
-static GPIOEXTI* btn3 = nullptr;
+static GPIOInput* btn0 = nullptr;
+static GPIOInput* btn1 = nullptr; 
+static GPIOInput* btn2 = nullptr;
+static GPIOInput* btn3 = nullptr;
+
+// Software timers on TIM7
+static TIMER::TimerWheel timerWheel;
+
+// Debounced button edges posted from the TIM7 interrupt, handled in App_Run
+static PinEventQueue buttonEvents;
+static Debouncer buttonDebouncer(buttonEvents);
 
 // LED patterns
 static uint32_t ledPattern = 0;
 
+// Blink periods (milliseconds)
+static constexpr uint32_t SLOW_BLINK_MS = 500;
+static constexpr uint32_t FAST_BLINK_MS = 100;
+
+static void blinkLed(void*);
+static TIMER::Timer blinkTimer(blinkLed, nullptr, TIMER::Context::THREAD);
+
+// Main loop: runs tasks and thread-context timers, sleeps in between
+static LOOP::EventLoop eventLoop(&timerWheel);
+
+// CPU load report period (milliseconds)
+static constexpr uint32_t LOAD_REPORT_MS = 10000;
+
+static void reportLoad(void*);
+static TIMER::Timer loadTimer(reportLoad, nullptr, TIMER::Context::THREAD);
+
 /**
  * @brief C wrapper for GPIO interrupt handling
  * 
@@ -37,112 +68,212 @@ static uint32_t ledPattern = 0;
  */
 extern "C" void GPIO_EXTI_HandleInterrupt(uint32_t pin)
 {
+    STACK::sampleMsp();
     GPIO::GPIOEXTI::handleInterrupt(pin);
 }
 
 /**
- * @brief Button 0 (PC0) interrupt callback
+ * @brief C wrapper for the shared-vector EXTI dispatcher
+ * 
+ * Called from EXTI4_IRQHandler, EXTI9_5_IRQHandler and EXTI15_10_IRQHandler
+ * with the mask of the lines served by that vector.
+ */
+extern "C" void GPIO_EXTI_Dispatch(uint32_t lines)
+{
+    STACK::sampleMsp();
+    GPIO::GPIOEXTI::dispatch(lines);
+}
+
+/**
+ * @brief C wrapper for the timer wheel interrupt
+ * 
+ * Called from TIM7_IRQHandler in stm32l4xx_it.c.
+ */
+extern "C" void TIMER_HandleInterrupt(void)
+{
+    STACK::sampleMsp();
+    TIMER::TimerWheel::handleInterrupt();
+}
+
+/**
+ * @brief Blink timer callback (main loop, via runDeferred)
+ */
+static void blinkLed(void*)
+{
+    if (led) {
+        led->toggle();
+    }
+}
+
+/**
+ * @brief Log the CPU load of the last report period and the stack high-water marks (main loop, via runDeferred)
+ */
+static void reportLoad(void*)
+{
+    const LOOP::Stats stats = eventLoop.getStats();
+    const uint32_t load = eventLoop.getLoadPermille();
+    LOG_MSG("CPU load %u.%u%% (%u sleeps, %u tasks, %u hot-path allocations)\n",
+            static_cast<unsigned>(load / 10U), static_cast<unsigned>(load % 10U),
+            static_cast<unsigned>(stats.sleeps), static_cast<unsigned>(stats.dispatches),
+            static_cast<unsigned>(MEMORY::getHotPathAllocations()));
+    STACK::printUsage();
+    eventLoop.resetStats();
+}
+
+/**
+ * @brief Button 0 (PC0) press handler (main loop)
  * 
  * Toggles the LED when button 0 is pressed
  */
-void btn0InterruptCallback()
+static void btn0Pressed()
 {
-    printf("Button 0 pressed - Toggling LED\n");
+    LOG_MSG("Button 0 pressed - Toggling LED\n");
     if (led) {
         led->toggle();
     }
 }
 
 /**
- * @brief Button 1 (PC1) interrupt callback
+ * @brief Button 1 (PC1) press handler (main loop)
  * 
  * Turns LED on when button 1 is pressed
  */
-void btn1InterruptCallback()
+static void btn1Pressed()
 {
-    printf("Button 1 pressed - LED ON\n");
+    LOG_MSG("Button 1 pressed - LED ON\n");
     if (led) {
         led->set();
     }
 }
 
 /**
- * @brief Button 2 (PC2) interrupt callback
+ * @brief Button 2 (PC2) press handler (main loop)
  * 
  * Turns LED off when button 2 is pressed  
  */
-void btn2InterruptCallback()
+static void btn2Pressed()
 {
-    printf("Button 2 pressed - LED OFF\n");
+    LOG_MSG("Button 2 pressed - LED OFF\n");
     if (led) {
         led->reset();
     }
 }
 
 /**
- * @brief Button 3 (PC3) interrupt callback
+ * @brief Button 3 (PC3) press handler (main loop)
  * 
  * Cycles through LED patterns when button 3 is pressed
  */
-void btn3InterruptCallback()
+static void btn3Pressed()
 {
     ledPattern = (ledPattern + 1) % 4;
-    printf("Button 3 pressed - LED Pattern: %lu\n", ledPattern);
+    LOG_MSG("Button 3 pressed - LED Pattern: %lu\n", ledPattern);
     
     if (led) {
         switch (ledPattern) {
             case 0:
+                timerWheel.stop(blinkTimer);
                 led->reset();
-                printf("Pattern: OFF\n");
+                LOG_MSG("Pattern: OFF\n");
                 break;
             case 1:
+                timerWheel.stop(blinkTimer);
                 led->set();
-                printf("Pattern: ON\n");
+                LOG_MSG("Pattern: ON\n");
                 break;
             case 2:
-                // Rapid toggle pattern will be handled in main loop
-                printf("Pattern: SLOW BLINK\n");
+                // First toggle on the next tick, then every period
+                timerWheel.startPeriodic(blinkTimer, TIMER::TimerWheel::msToTicks(SLOW_BLINK_MS), 0);
+                LOG_MSG("Pattern: SLOW BLINK\n");
                 break;
             case 3:
-                // Fast toggle pattern will be handled in main loop
-                printf("Pattern: FAST BLINK\n");
+                timerWheel.startPeriodic(blinkTimer, TIMER::TimerWheel::msToTicks(FAST_BLINK_MS), 0);
+                LOG_MSG("Pattern: FAST BLINK\n");
                 break;
         }
     }
 }
 
+/**
+ * @brief Handle a batch of button events drained from buttonEvents
+ * 
+ * Runs in the main loop, so logging and LED updates no longer extend the ISRs.
+ * The buttons pull low when pressed; releases (rising edges) are ignored.
+ */
+static void handleButtonEvents(const PinEvent* events, uint32_t count, void*)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        if (events[i].edge != Edge::FALLING) {
+            continue;
+        }
+        switch (events[i].pin) {
+            case 0: btn0Pressed(); break;
+            case 1: btn1Pressed(); break;
+            case 2: btn2Pressed(); break;
+            case 3: btn3Pressed(); break;
+            default: break;
+        }
+    }
+}
+
+/**
+ * @brief Button task: drain the debounced events
+ */
+static void runButtonTask(void*)
+{
+    buttonEvents.process(handleButtonEvents);
+}
+
+/**
+ * @brief Button task has work while events are queued (interrupts masked)
+ */
+static bool buttonTaskReady(void*)
+{
+    return !buttonEvents.isEmpty();
+}
+
+/**
+ * @brief Log task: forward records that did not fit into the UART ring earlier
+ * 
+ * Polled after every wake-up; the UART interrupts wake the loop while output is pending.
+ */
+static void runLogTask(void*)
+{
+    LOG::flush();
+}
+
+// The GPIO objects below are created with new: they must fit a pool block should the init arena run out
+static_assert(MEMORY::fitsPool<GPIOOutput>() && MEMORY::fitsPool<GPIOInput>(),
+              "GPIO driver objects must fit MEMORY::MAX_BLOCK_SIZE");
+
+// Everything App_Init() creates with new (one output, four inputs) is served by the init arena
+static_assert(MEMORY::arenaFootprint(sizeof(GPIOOutput)) + 4U * MEMORY::arenaFootprint(sizeof(GPIOInput)) <=
+              MEMORY_INIT_ARENA_SIZE, "Raise MEMORY_INIT_ARENA_SIZE for the objects App_Init() creates");
+
 void App_Init(void)
 {
-    printf("=== STM32L433 LPUART1 Debug Interface Active ===\n");
-    printf("App_Init: Initializing GPIO example...\n");
+    LOG_MSG("=== STM32L433 LPUART1 Debug Interface Active ===\n");
+    LOG_MSG("App_Init: Initializing GPIO example...\n");
     
     // Create LED on PB11 (push-pull output, low speed)
     led = new GPIOOutput(GPIOB, 11, PinOutputType::PUSH_PULL, PinSpeed::LOW);
     
-    // Create buttons on PC0-PC3 with pull-up resistors and falling edge trigger
-    btn0 = new GPIOEXTI(GPIOC, 0, EXTITrigger::FALLING, PinPull::PULL_UP);
-    btn1 = new GPIOEXTI(GPIOC, 1, EXTITrigger::FALLING, PinPull::PULL_UP);
-    btn2 = new GPIOEXTI(GPIOC, 2, EXTITrigger::FALLING, PinPull::PULL_UP);
-    btn3 = new GPIOEXTI(GPIOC, 3, EXTITrigger::FALLING, PinPull::PULL_UP);
+    // Create buttons on PC0-PC3 with pull-up resistors
+    btn0 = new GPIOInput(GPIOC, 0, PinPull::PULL_UP);
+    btn1 = new GPIOInput(GPIOC, 1, PinPull::PULL_UP);
+    btn2 = new GPIOInput(GPIOC, 2, PinPull::PULL_UP);
+    btn3 = new GPIOInput(GPIOC, 3, PinPull::PULL_UP);
     
-    // Set up interrupt callbacks
-    btn0->setCallback(btn0InterruptCallback);
-    btn1->setCallback(btn1InterruptCallback);
-    btn2->setCallback(btn2InterruptCallback);  
-    btn3->setCallback(btn3InterruptCallback);
+    timerWheel.begin();
     
-    // Enable interrupts
-    btn0->enableInterrupt();
-    btn1->enableInterrupt();
-    btn2->enableInterrupt();
-    btn3->enableInterrupt();
+    // Sampled from a wheel timer; only clean presses/releases reach buttonEvents
+    buttonDebouncer.watch(*btn0);
+    buttonDebouncer.watch(*btn1);
+    buttonDebouncer.watch(*btn2);
+    buttonDebouncer.watch(*btn3);
+    buttonDebouncer.start(timerWheel);
     
-    // Debug: Print interrupt enable status
-    printf("Button interrupts enabled:\n");
-    printf("- btn0 (PC0): %s\n", btn0->isInterruptEnabled() ? "ENABLED" : "DISABLED");
-    printf("- btn1 (PC1): %s\n", btn1->isInterruptEnabled() ? "ENABLED" : "DISABLED"); 
-    printf("- btn2 (PC2): %s\n", btn2->isInterruptEnabled() ? "ENABLED" : "DISABLED");
-    printf("- btn3 (PC3): %s\n", btn3->isInterruptEnabled() ? "ENABLED" : "DISABLED");
+    LOG_MSG("Buttons debounced every %u ms\n", static_cast<unsigned>(GPIO_DEBOUNCE_PERIOD_MS));
     
     // Start with LED off
     led->reset();
@@ -151,57 +282,33 @@ void App_Init(void)
     led->set( );
     
     // Debug: Test button pin states (should be HIGH with pull-up when not pressed)
-    printf("Initial button pin states:\n");
-    printf("- PC0: %s\n", btn0->read() == PinState::HIGH ? "HIGH (not pressed)" : "LOW (pressed?)");
-    printf("- PC1: %s\n", btn1->read() == PinState::HIGH ? "HIGH (not pressed)" : "LOW (pressed?)");
-    printf("- PC2: %s\n", btn2->read() == PinState::HIGH ? "HIGH (not pressed)" : "LOW (pressed?)");
-    printf("- PC3: %s\n", btn3->read() == PinState::HIGH ? "HIGH (not pressed)" : "LOW (pressed?)");
-
-    printf("GPIO Example initialized:\n");
-    printf("- LED on PB11\n");
-    printf("- Button 0 (PC0): Toggle LED\n");
-    printf("- Button 1 (PC1): LED ON\n");
-    printf("- Button 2 (PC2): LED OFF\n");
-    printf("- Button 3 (PC3): Cycle LED patterns\n");
+    LOG_MSG("Initial button pin states:\n");
+    LOG_MSG("- PC0: %s\n", btn0->read() == PinState::HIGH ? "HIGH (not pressed)" : "LOW (pressed?)");
+    LOG_MSG("- PC1: %s\n", btn1->read() == PinState::HIGH ? "HIGH (not pressed)" : "LOW (pressed?)");
+    LOG_MSG("- PC2: %s\n", btn2->read() == PinState::HIGH ? "HIGH (not pressed)" : "LOW (pressed?)");
+    LOG_MSG("- PC3: %s\n", btn3->read() == PinState::HIGH ? "HIGH (not pressed)" : "LOW (pressed?)");
+
+    LOG_MSG("GPIO Example initialized:\n");
+    LOG_MSG("- LED on PB11\n");
+    LOG_MSG("- Button 0 (PC0): Toggle LED\n");
+    LOG_MSG("- Button 1 (PC1): LED ON\n");
+    LOG_MSG("- Button 2 (PC2): LED OFF\n");
+    LOG_MSG("- Button 3 (PC3): Cycle LED patterns\n");
+
+    // Driver objects are in place: from here on the loop must not allocate
+    MEMORY::freeze();
+    MEMORY::printStats();
 }
 
 void App_Run(void)
 {
-    printf("App_Run: Starting main application loop\n");
+    LOG_MSG("App_Run: Starting main application loop\n");
     
-    uint32_t slowBlinkCounter = 0;
-    uint32_t fastBlinkCounter = 0;
+    eventLoop.addTask(runButtonTask, nullptr, buttonTaskReady);
+    eventLoop.addTask(runLogTask);
     
-    while (true) {
-        // Handle LED blinking patterns
-        switch (ledPattern) {
-            case 2: // Slow blink
-                slowBlinkCounter++;
-                if (slowBlinkCounter >= 500000) { // Adjust timing as needed
-                    led->toggle();
-                    slowBlinkCounter = 0;
-                }
-                break;
-                
-            case 3: // Fast blink
-                fastBlinkCounter++;
-                if (fastBlinkCounter >= 100000) { // Adjust timing as needed
-                    led->toggle();
-                    fastBlinkCounter = 0;
-                }
-                break;
-                
-            default:
-                // Reset counters for patterns 0 and 1
-                slowBlinkCounter = 0;
-                fastBlinkCounter = 0;
-                break;
-        }
-        
-        // Small delay to prevent busy waiting
-        for ( int i = 0; i < 100; i++)
-        {
-        	__NOP( );
-        }
-    }
+    timerWheel.startPeriodic(loadTimer, TIMER::TimerWheel::msToTicks(LOAD_REPORT_MS));
+    
+    // Never returns: dispatch, then sleep until the next deadline or interrupt
+    eventLoop.run();
 }
@@ -27,6 +27,9 @@
 // For printf debug interface
 extern void initialise_monitor_handles(void);
 
+// Monotonic time base (Utils/Src/SystemTime.cpp)
+extern void TIME_Init(void);
+
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -92,6 +95,7 @@ int main(void)
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
+  TIME_Init();
 
   /* USER CODE END SysInit */
 
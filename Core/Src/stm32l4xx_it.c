@@ -28,15 +28,24 @@
 extern "C" {
 #endif
 
-// Forward declaration for C++ USART interrupt handler
-void USART_HandleLpuart1Interrupt(void);
+// Forward declaration for C++ USART interrupt dispatch (index = USART::PeripheralType)
+void USART_HandleInterrupt(uint32_t peripheral);
+void USART_HandleDmaTxInterrupt(uint32_t peripheral);
+void USART_HandleDmaRxInterrupt(uint32_t peripheral);
 
 #ifdef __cplusplus
 }
 #endif
 
-// Forward declaration for C++ GPIO interrupt handler
+// Forward declarations for C++ GPIO interrupt handlers
 extern void GPIO_EXTI_HandleInterrupt(uint32_t pin);
+extern void GPIO_EXTI_Dispatch(uint32_t lines);
+
+// Forward declaration for the C++ debouncer sampling interrupt
+extern void TIMER_HandleInterrupt(void);
+
+// Forward declaration for the C++ time base (SysTick millisecond tick)
+extern void TIME_HandleSysTick(void);
 
 #ifdef __cplusplus
 }
@@ -50,7 +59,10 @@ extern void GPIO_EXTI_HandleInterrupt(uint32_t pin);
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
-
+#define USART_PERIPHERAL_USART1   0U
+#define USART_PERIPHERAL_USART2   1U
+#define USART_PERIPHERAL_USART3   2U
+#define USART_PERIPHERAL_LPUART1  3U
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -183,25 +195,13 @@ void DebugMon_Handler(void)
   /* USER CODE END DebugMonitor_IRQn 1 */
 }
 
-/**
-  * @brief This function handles Pendable request for system service.
-  */
-void PendSV_Handler(void)
-{
-  /* USER CODE BEGIN PendSV_IRQn 0 */
-
-  /* USER CODE END PendSV_IRQn 0 */
-  /* USER CODE BEGIN PendSV_IRQn 1 */
-
-  /* USER CODE END PendSV_IRQn 1 */
-}
-
 /**
   * @brief This function handles System tick timer.
   */
 void SysTick_Handler(void)
 {
   /* USER CODE BEGIN SysTick_IRQn 0 */
+  TIME_HandleSysTick();
 
   /* USER CODE END SysTick_IRQn 0 */
 
@@ -306,6 +306,7 @@ void TIM7_IRQHandler(void)
 
   /* USER CODE END TIM7_IRQn 0 */
   /* USER CODE BEGIN TIM7_IRQn 1 */
+  TIMER_HandleInterrupt();
 
   /* USER CODE END TIM7_IRQn 1 */
 }
@@ -319,10 +320,123 @@ void LPUART1_IRQHandler(void)
 
   /* USER CODE END LPUART1_IRQn 0 */
   /* USER CODE BEGIN LPUART1_IRQn 1 */
-  USART_HandleLpuart1Interrupt();
+  USART_HandleInterrupt(USART_PERIPHERAL_LPUART1);
   /* USER CODE END LPUART1_IRQn 1 */
 }
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles EXTI line4 interrupt.
+  */
+void EXTI4_IRQHandler(void)
+{
+  GPIO_EXTI_Dispatch(LL_EXTI_LINE_4);
+}
+
+/**
+  * @brief This function handles EXTI line[9:5] interrupts.
+  */
+void EXTI9_5_IRQHandler(void)
+{
+  GPIO_EXTI_Dispatch(LL_EXTI_LINE_5 | LL_EXTI_LINE_6 | LL_EXTI_LINE_7 | LL_EXTI_LINE_8 | LL_EXTI_LINE_9);
+}
+
+/**
+  * @brief This function handles EXTI line[15:10] interrupts.
+  */
+void EXTI15_10_IRQHandler(void)
+{
+  GPIO_EXTI_Dispatch(LL_EXTI_LINE_10 | LL_EXTI_LINE_11 | LL_EXTI_LINE_12 |
+                     LL_EXTI_LINE_13 | LL_EXTI_LINE_14 | LL_EXTI_LINE_15);
+}
+
+/**
+  * @brief This function handles USART1 global interrupt.
+  */
+void USART1_IRQHandler(void)
+{
+  USART_HandleInterrupt(USART_PERIPHERAL_USART1);
+}
+
+/**
+  * @brief This function handles USART2 global interrupt.
+  */
+void USART2_IRQHandler(void)
+{
+  USART_HandleInterrupt(USART_PERIPHERAL_USART2);
+}
+
+/**
+  * @brief This function handles USART3 global interrupt.
+  */
+void USART3_IRQHandler(void)
+{
+  USART_HandleInterrupt(USART_PERIPHERAL_USART3);
+}
+
+/**
+  * @brief This function handles DMA1 channel2 global interrupt (USART3_TX).
+  */
+void DMA1_Channel2_IRQHandler(void)
+{
+  USART_HandleDmaTxInterrupt(USART_PERIPHERAL_USART3);
+}
+
+/**
+  * @brief This function handles DMA1 channel3 global interrupt (USART3_RX).
+  */
+void DMA1_Channel3_IRQHandler(void)
+{
+  USART_HandleDmaRxInterrupt(USART_PERIPHERAL_USART3);
+}
+
+/**
+  * @brief This function handles DMA1 channel4 global interrupt (USART1_TX).
+  */
+void DMA1_Channel4_IRQHandler(void)
+{
+  USART_HandleDmaTxInterrupt(USART_PERIPHERAL_USART1);
+}
+
+/**
+  * @brief This function handles DMA1 channel5 global interrupt (USART1_RX).
+  */
+void DMA1_Channel5_IRQHandler(void)
+{
+  USART_HandleDmaRxInterrupt(USART_PERIPHERAL_USART1);
+}
+
+/**
+  * @brief This function handles DMA1 channel6 global interrupt (USART2_RX).
+  */
+void DMA1_Channel6_IRQHandler(void)
+{
+  USART_HandleDmaRxInterrupt(USART_PERIPHERAL_USART2);
+}
+
+/**
+  * @brief This function handles DMA1 channel7 global interrupt (USART2_TX).
+  */
+void DMA1_Channel7_IRQHandler(void)
+{
+  USART_HandleDmaTxInterrupt(USART_PERIPHERAL_USART2);
+}
+
+/**
+  * @brief This function handles DMA2 channel6 global interrupt (LPUART1_TX).
+  */
+void DMA2_Channel6_IRQHandler(void)
+{
+  USART_HandleDmaTxInterrupt(USART_PERIPHERAL_LPUART1);
+}
+
+/**
+  * @brief This function handles DMA2 channel7 global interrupt (LPUART1_RX).
+  */
+void DMA2_Channel7_IRQHandler(void)
+{
+  USART_HandleDmaRxInterrupt(USART_PERIPHERAL_LPUART1);
+}
+
 /* USER CODE END 1 */
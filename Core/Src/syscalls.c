@@ -39,6 +39,8 @@ extern void* USART_CreateDebugInstance(void);
 extern void USART_Initialize(void* instance, void* config);
 extern void* USART_GetDefaultLpuartConfig(void);
 extern void USART_SendChar(void* instance, char c);
+extern int USART_Receive(void* instance, char* buffer, int length);
+extern int LOG_Write(const char* data, int length);
 
 
 
@@ -83,22 +85,49 @@ void _exit (int status)
   while (1) {}    /* Make sure we hang here */
 }
 
+/**
+ * @brief Read function wrapper
+ * @details Waits until the LPUART1 RX DMA has delivered at least one byte,
+ *          then returns everything that is buffered (up to len)
+ * @param file - File descriptor (only STDIN_FILENO is served by the UART)
+ * @param *ptr - Destination buffer
+ * @param len - Capacity of the destination buffer
+ * @return Number of bytes read on success, -1 on error
+ */
 __attribute__((weak)) int _read(int file, char *ptr, int len)
 {
-  (void)file;
-  int DataIdx;
+  if (file != STDIN_FILENO)
+  {
+    errno = EBADF;
+    return -1;
+  }
+
+  if (debug_usart_instance == NULL)
+  {
+    int DataIdx;
+
+    for (DataIdx = 0; DataIdx < len; DataIdx++)
+    {
+      *ptr++ = __io_getchar();
+    }
+
+    return len;
+  }
 
-  for (DataIdx = 0; DataIdx < len; DataIdx++)
+  int received;
+  while ((received = USART_Receive(debug_usart_instance, ptr, len)) == 0)
   {
-    *ptr++ = __io_getchar();
+    // IDLE-line and DMA half/full interrupts wake us when data arrives
+    __WFI();
   }
 
-  return len;
+  return received;
 }
 
 /**
  * @brief Write function wrapper
- * @details Transfers pointer and data size to the UART Transmit function
+ * @details Queues the data as log records (LOG_Write), so printf from thread mode
+ *          and interrupts never interleaves; bytes that do not fit are dropped
  * @param file - File descriptor (e.g., STDOUT_FILENO for stdout, STDERR_FILENO for stderr)
  * @param *ptr - Pointer to data
  * @param len - Length of data
@@ -110,9 +139,7 @@ int _write(int file, char *ptr, int len)
     {
         if (debug_usart_instance != NULL) {
             // Send data via LPUART1
-            for (int i = 0; i < len; i++) {
-                USART_SendChar(debug_usart_instance, ptr[i]);
-            }
+            LOG_Write(ptr, len);
             return len;
         }
         return len; // Return success even if USART not initialized
@@ -29,6 +29,11 @@
  */
 static uint8_t *__sbrk_heap_end = NULL;
 
+/**
+ * Number of _sbrk() calls refused with ENOMEM
+ */
+static uint32_t __sbrk_failures = 0;
+
 /**
  * @brief _sbrk() allocates memory to the newlib heap and is used by malloc
  *        and others from the C library
@@ -69,6 +74,7 @@ void *_sbrk(ptrdiff_t incr)
   if (__sbrk_heap_end + incr > max_heap)
   {
     errno = ENOMEM;
+    __sbrk_failures++;
     return (void *)-1;
   }
 
@@ -77,3 +83,39 @@ void *_sbrk(ptrdiff_t incr)
 
   return (void *)prev_heap_end;
 }
+
+/**
+ * @brief Current end of the newlib heap (the _sbrk break)
+ */
+uintptr_t SYSMEM_GetHeapBreak(void)
+{
+  extern uint8_t _end; /* Symbol defined in the linker script */
+  return (NULL == __sbrk_heap_end) ? (uintptr_t)&_end : (uintptr_t)__sbrk_heap_end;
+}
+
+/**
+ * @brief Start of the newlib heap
+ */
+uintptr_t SYSMEM_GetHeapStart(void)
+{
+  extern uint8_t _end; /* Symbol defined in the linker script */
+  return (uintptr_t)&_end;
+}
+
+/**
+ * @brief Highest address the break may reach (bottom of the reserved MSP stack)
+ */
+uintptr_t SYSMEM_GetHeapLimit(void)
+{
+  extern uint8_t _estack; /* Symbol defined in the linker script */
+  extern uint32_t _Min_Stack_Size; /* Symbol defined in the linker script */
+  return (uintptr_t)&_estack - (uintptr_t)&_Min_Stack_Size;
+}
+
+/**
+ * @brief Number of _sbrk() requests refused because the heap would hit the stack
+ */
+uint32_t SYSMEM_GetSbrkFailures(void)
+{
+  return __sbrk_failures;
+}
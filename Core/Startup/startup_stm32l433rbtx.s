@@ -95,6 +95,36 @@ LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
 
+/* Zero fill the SRAM2 bss segment (RAM2_BSS). */
+  ldr r2, =_sram2_bss
+  ldr r4, =_eram2_bss
+  movs r3, #0
+  b LoopFillZeroRam2bss
+
+FillZeroRam2bss:
+  str  r3, [r2]
+  adds r2, r2, #4
+
+LoopFillZeroRam2bss:
+  cmp r2, r4
+  bcc FillZeroRam2bss
+
+/* Paint the MSP stack reserve for the high-water scanner (STACK_PAINT_PATTERN) */
+  ldr r2, =_estack
+  ldr r3, =_Min_Stack_Size
+  subs r2, r2, r3
+  mov r4, sp
+  ldr r3, =0xA5A5A5A5
+  b LoopPaintStack
+
+PaintStack:
+  str  r3, [r2]
+  adds r2, r2, #4
+
+LoopPaintStack:
+  cmp r2, r4
+  bcc PaintStack
+
 /* Call static constructors */
     bl __libc_init_array
 /* Call the application's entry point.*/
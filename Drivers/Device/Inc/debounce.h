@@ -0,0 +1,144 @@
+/**
+ * @file debounce.h
+ * @brief Timer-sampled debouncer for up to 16 input lines using vertical counters
+ *
+ * Instead of taking an interrupt per (bouncing) edge, the debouncer samples the
+ * IDR of every watched port from a periodic TIMER::Timer (TIM7 interrupt
+ * context) and runs a 2-bit vertical counter across all 16 pins of a port at
+ * once:
+ *
+ * @code
+ * delta   = sample ^ state;            // pins that differ from the debounced state
+ * count1  = (count1 ^ count0) & delta; // per-pin 2-bit counter, reset where equal
+ * count0  = ~count0 & delta;
+ * toggle  = delta & ~(count0 | count1);// counter wrapped: 4 equal samples in a row
+ * state  ^= toggle;
+ * @endcode
+ *
+ * A pin changes its debounced state only after it has read the new level for
+ * four consecutive samples; each change is delivered as one PinEvent. The cost per
+ * tick is a handful of ALU operations per watched port, independent of the number
+ * of pins, and bounce never reaches the CPU as interrupts.
+ *
+ * Lines are identified by pin number like EXTI lines: at most one port per pin
+ * number can be watched.
+ */
+
+#ifndef DEVICE_INC_DEBOUNCE_H_
+#define DEVICE_INC_DEBOUNCE_H_
+
+#include "main.h"
+#include "gpio.h"
+#include "gpio_event.h"
+#include "timer_wheel.h"
+
+#include <cstdint>
+
+#ifndef GPIO_DEBOUNCE_PERIOD_MS
+#define GPIO_DEBOUNCE_PERIOD_MS 5U   // Sample period; a change must be stable for 4 periods
+#endif
+
+namespace GPIO
+{
+    /**
+     * @class Debouncer
+     * @brief Debounces watched pins in parallel and posts clean edges to a PinEventQueue
+     *
+     * Any number of instances can share one TIMER::TimerWheel.
+     */
+    class Debouncer
+    {
+    public:
+        /**
+         * @brief Construct a debouncer posting to a queue
+         * @param queue Queue receiving one event per debounced press/release
+         */
+        explicit Debouncer(PinEventQueue& queue);
+
+        /**
+         * @brief Stop sampling
+         */
+        ~Debouncer();
+
+        Debouncer(const Debouncer&) = delete;
+        Debouncer& operator=(const Debouncer&) = delete;
+
+        /**
+         * @brief Add a pin to the debounced set
+         *
+         * The pin must already be configured as input (e.g. a GPIOInput). Its current
+         * level becomes the initial debounced state, so no event is posted for it.
+         *
+         * @param port GPIO port (GPIOA, GPIOB, etc.)
+         * @param pin Pin number (0-15)
+         * @return false if the pin number is out of range or already watched on another port
+         */
+        bool watch(GPIO_TypeDef* port, uint32_t pin);
+
+        /**
+         * @brief Add an input pin object to the debounced set
+         * @param input Configured input pin
+         * @return false if the pin could not be added
+         */
+        bool watch(const GPIOBase& input) { return watch(input.getPort(), input.getPin()); }
+
+        /**
+         * @brief Remove a pin from the debounced set
+         * @param port GPIO port
+         * @param pin Pin number (0-15)
+         */
+        void unwatch(GPIO_TypeDef* port, uint32_t pin);
+
+        /**
+         * @brief Start sampling on a timer wheel
+         * @param wheel Running timer wheel
+         * @param periodMs Sample period in milliseconds
+         */
+        void start(TIMER::TimerWheel& wheel, uint32_t periodMs = GPIO_DEBOUNCE_PERIOD_MS);
+
+        /**
+         * @brief Stop sampling
+         */
+        void stop();
+
+        /**
+         * @brief Get the debounced level of a pin
+         * @param port GPIO port
+         * @param pin Pin number (0-15)
+         * @return Debounced level (LOW for pins that are not watched)
+         */
+        PinState getState(GPIO_TypeDef* port, uint32_t pin) const;
+
+        /**
+         * @brief Sample all watched ports and post the pins that changed (interrupt context)
+         */
+        void sample();
+
+    private:
+        static constexpr uint32_t PORT_COUNT = 8;   ///< GPIOA..GPIOH slots (0x400 apart)
+
+        /**
+         * @brief Vertical counter state of one port, bit n = pin n
+         */
+        struct PortState
+        {
+            uint32_t mask;     ///< Watched pins
+            uint32_t state;    ///< Debounced levels
+            uint32_t count0;   ///< Counter bit 0
+            uint32_t count1;   ///< Counter bit 1
+        };
+
+        PinEventQueue& queue_;
+        TIMER::Timer timer_;
+        TIMER::TimerWheel* wheel_ = nullptr;   ///< Set while sampling
+        PortState ports_[PORT_COUNT] = {};
+        uint32_t watchedLines_ = 0;   ///< Pin numbers in use on any port
+
+        static void onTimer(void* context);
+        static uint32_t getPortIndex(GPIO_TypeDef* port);
+        static GPIO_TypeDef* getPort(uint32_t index);
+    };
+
+} // namespace GPIO
+
+#endif /* DEVICE_INC_DEBOUNCE_H_ */
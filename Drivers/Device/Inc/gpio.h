@@ -21,8 +21,9 @@
 #include "stm32l4xx_ll_exti.h"
 
 #include <vector>
+#include <cstddef>
 #include <cstdint>
-#include <functional>
+#include <type_traits>
 
 /**
  * @namespace GPIO
@@ -122,15 +123,94 @@ namespace GPIO
     class GPIOOutput;
     class GPIOInput;
     class GPIOEXTI;
+    class PinEventQueue;
+    class EdgeTimer;
 
     /**
-     * @typedef InterruptCallback
-     * @brief Function pointer type for interrupt callbacks
+     * @class InterruptCallback
+     * @brief Heap-free interrupt callback: a function pointer plus a context pointer
      * 
-     * Defines the signature for interrupt callback functions.
+     * Fixed size (two pointers), never allocates, and calling it is one indirect
+     * call. Accepts plain functions, captureless lambdas, functions taking a context
+     * pointer, and member functions bound to an object via bind().
      * These functions are called from interrupt context, so they should be fast and non-blocking.
+     * 
+     * @code
+     * btn->setCallback([]() { flag = true; });
+     * btn->setCallback(onEdge, &state);                                 // void onEdge(void*)
+     * btn->setCallback(InterruptCallback::bind<Motor, &Motor::stop>(&motor));
+     * @endcode
      */
-    using InterruptCallback = std::function<void(void)>;
+    class InterruptCallback
+    {
+    public:
+        using Function = void (*)(void* context);   ///< Callback taking a context pointer
+        using PlainFunction = void (*)(void);       ///< Callback without context
+
+        /**
+         * @brief Construct an empty callback
+         */
+        constexpr InterruptCallback() = default;
+        constexpr InterruptCallback(std::nullptr_t) {}
+
+        /**
+         * @brief Construct from a function and the context passed to it
+         * @param function Function to call (nullptr for an empty callback)
+         * @param context Pointer handed to the function on every call
+         */
+        constexpr InterruptCallback(Function function, void* context)
+            : function_(function), context_(context) {}
+
+        /**
+         * @brief Construct from a plain function or captureless lambda
+         * @note Lambdas with captures are rejected at compile time (no storage for them)
+         */
+        template<typename F, typename = typename std::enable_if<std::is_convertible<F, PlainFunction>::value>::type>
+        InterruptCallback(F function)
+            : InterruptCallback(static_cast<PlainFunction>(function)) {}
+
+        InterruptCallback(PlainFunction function)
+            : function_(function ? &callPlain : nullptr),
+              context_(reinterpret_cast<void*>(function)) {}
+
+        /**
+         * @brief Bind a member function to an object
+         * @tparam T Object type
+         * @tparam Method Member function to call on the object
+         * @param object Object the member function is called on
+         */
+        template<typename T, void (T::*Method)()>
+        static InterruptCallback bind(T* object)
+        {
+            return InterruptCallback(&callMember<T, Method>, object);
+        }
+
+        /**
+         * @brief Invoke the callback
+         * @warning The callback must not be empty
+         */
+        void operator()() const { function_(context_); }
+
+        /**
+         * @brief Check whether a function is set
+         */
+        explicit operator bool() const { return function_ != nullptr; }
+
+    private:
+        Function function_ = nullptr;   ///< Function to call
+        void* context_ = nullptr;       ///< Argument for function_
+
+        static void callPlain(void* context)
+        {
+            reinterpret_cast<PlainFunction>(context)();
+        }
+
+        template<typename T, void (T::*Method)()>
+        static void callMember(void* context)
+        {
+            (static_cast<T*>(context)->*Method)();
+        }
+    };
 
     /**
      * @struct PinConfig
@@ -531,9 +611,10 @@ namespace GPIO
     class GPIOEXTI : public GPIOInput
     {
     private:
-        static InterruptCallback callbacks_[16];  ///< Static callback array for all EXTI lines (0-15)
         EXTITrigger trigger_;           ///< Current interrupt trigger configuration
         InterruptCallback callback_;    ///< User callback function for this pin
+        PinEventQueue* eventQueue_;     ///< Queue receiving an event per edge (nullptr = none)
+        EdgeTimer* edgeTimer_;          ///< Edge history for timing queries (nullptr = none)
         bool interruptEnabled_;         ///< Current interrupt enable state
 
         /**
@@ -554,6 +635,16 @@ namespace GPIO
          */
         void configureEXTI();
 
+        /**
+         * @brief Serve one interrupt of this pin (interrupt context)
+         * 
+         * Records the edge in the attached EdgeTimer and posts it to the attached
+         * queue, if any, then runs the callback, if any.
+         * 
+         * @param timestamp Cycle time (TIME::nowCycles32()) taken at ISR entry
+         */
+        void onInterrupt(uint32_t timestamp);
+
     public:
         /**
          * @brief Construct a new GPIOEXTI object
@@ -624,12 +715,44 @@ namespace GPIO
          * Registers a function to be called when the interrupt occurs.
          * The callback should be fast and non-blocking as it runs in interrupt context.
          * 
-         * @param callback Function to call on interrupt (lambda, function pointer, etc.)
+         * @param callback Function to call on interrupt (function pointer, captureless lambda, bound member)
          * 
          * @warning Callback runs in interrupt context - keep it short and fast
-         * @note Use std::function, lambdas, or function pointers
+         * @note Never allocates; the EXTI line is masked while the callback is replaced
          */
         void setCallback(InterruptCallback callback);
+
+        /**
+         * @brief Set an interrupt callback that receives a context pointer
+         * 
+         * @param function Function to call on interrupt
+         * @param context Pointer passed to the function on every call
+         */
+        void setCallback(InterruptCallback::Function function, void* context);
+
+        /**
+         * @brief Post an event per edge to a queue instead of doing the work in the ISR
+         * 
+         * Each interrupt then costs a timestamp read and a lock-free post of
+         * (pin, edge, timestamp); the main loop handles the events with
+         * PinEventQueue::process(). A callback, if also set, still runs in the ISR.
+         * 
+         * @param queue Queue to post to (nullptr to detach)
+         * @see gpio_event.h
+         */
+        void setEventQueue(PinEventQueue* queue);
+
+        /**
+         * @brief Record the timing of every edge for pulse width/period/frequency queries
+         * 
+         * The SysTick cycle time is taken at ISR entry, giving one-cycle resolution
+         * that keeps counting while the loop sleeps in WFI.
+         * Use the RISING_FALLING trigger to measure pulse widths.
+         * 
+         * @param timer Edge history to record into (nullptr to detach)
+         * @see gpio_timing.h
+         */
+        void setEdgeTimer(EdgeTimer* timer);
         
         /**
          * @brief Change the interrupt trigger condition
@@ -656,20 +779,30 @@ namespace GPIO
          */
         void clearInterruptFlag();
 
-        // Static interrupt handler (to be called from ISR)
+        // Static interrupt handlers (to be called from ISR)
         /**
-         * @brief Static interrupt handler for all EXTI pins
+         * @brief Serve the GPIOEXTI registered for one EXTI line
          * 
-         * Central interrupt handler that dispatches to individual pin callbacks.
-         * This method should be called from your EXTI interrupt service routines.
+         * For ISRs that have already checked and cleared the pending flag of the line
+         * (the CubeMX-generated EXTI0..EXTI3 handlers).
          * 
          * @param pin Pin number (0-15) that triggered the interrupt
-         * 
-         * @note Call this from your EXTIx_IRQHandler functions
-         * @see gpio_example.cpp for ISR implementation examples
          */
         static void handleInterrupt(uint32_t pin);
 
+        /**
+         * @brief Serve all pending EXTI lines of one interrupt vector
+         * 
+         * Reads the pending register once, clears every pending line of @p lines with a
+         * single write and serves the registered ones, lowest line first
+         * (found with CLZ). The pending register is sampled again afterwards, so edges
+         * that arrive while callbacks run are served in the same ISR entry.
+         * 
+         * @param lines EXTI line mask served by the calling vector (e.g. 0x03E0 for EXTI9_5)
+         * @note Call this from EXTI4_IRQHandler, EXTI9_5_IRQHandler and EXTI15_10_IRQHandler
+         */
+        static void dispatch(uint32_t lines);
+
         // Getters
         /**
          * @brief Check if interrupt is currently enabled
@@ -684,6 +817,297 @@ namespace GPIO
         EXTITrigger getTrigger() const { return trigger_; }
     };
 
+    //=============================================================================
+    // Compile-time pins
+    //=============================================================================
+
+    /**
+     * @enum Port
+     * @brief GPIO port selector usable as a template argument
+     *
+     * GPIOA..GPIOH are pointer casts and cannot be template arguments, so the
+     * ports are identified by their base addresses instead.
+     */
+    enum class Port : uint32_t
+    {
+        A = GPIOA_BASE,   ///< GPIOA
+        B = GPIOB_BASE,   ///< GPIOB
+        C = GPIOC_BASE,   ///< GPIOC
+        D = GPIOD_BASE,   ///< GPIOD
+        E = GPIOE_BASE,   ///< GPIOE
+        H = GPIOH_BASE    ///< GPIOH
+    };
+
+    /**
+     * @class Pin
+     * @brief Zero-overhead GPIO pin with port and pin number fixed at compile time
+     *
+     * All members are static and the register address and bit mask are constants,
+     * so with optimization enabled set()/reset()/write() compile to a single store
+     * to BSRR or BRR and read() to a single IDR load. There is no object state, no
+     * RAM and no virtual dispatch; the class is meant for bit-banging and tight
+     * control loops where the GPIOOutput/GPIOInput classes are too heavy.
+     *
+     * @tparam PORT GPIO port
+     * @tparam PIN Pin number (0-15)
+     *
+     * @code
+     * using Led = GPIO::Pin<GPIO::Port::B, 11>;
+     * Led::configureOutput();
+     * Led::set();
+     * @endcode
+     *
+     * @note Configuration helpers go through the LL driver and are not meant for hot paths
+     */
+    template<Port PORT, uint32_t PIN>
+    class Pin
+    {
+        static_assert(PIN < 16, "GPIO pin number must be in range 0-15");
+
+    public:
+        static constexpr uint32_t MASK = 1UL << PIN;   ///< Pin bit in IDR/ODR/BSRR/BRR
+
+        /**
+         * @brief Get the port registers
+         * @return Pointer to the GPIO port (constant address)
+         */
+        static GPIO_TypeDef* port() { return reinterpret_cast<GPIO_TypeDef*>(static_cast<uint32_t>(PORT)); }
+
+        /**
+         * @brief Enable the port clock and configure the pin as output
+         * @param outputType Output driver type (PUSH_PULL or OPEN_DRAIN)
+         * @param speed Output speed/drive strength
+         * @note The pin is driven LOW before it is switched to output mode
+         */
+        static void configureOutput(PinOutputType outputType = PinOutputType::PUSH_PULL,
+                                    PinSpeed speed = PinSpeed::LOW)
+        {
+            enableClock();
+            reset();
+            LL_GPIO_SetPinOutputType(port(), MASK, static_cast<uint32_t>(outputType));
+            LL_GPIO_SetPinSpeed(port(), MASK, static_cast<uint32_t>(speed));
+            LL_GPIO_SetPinPull(port(), MASK, LL_GPIO_PULL_NO);
+            LL_GPIO_SetPinMode(port(), MASK, LL_GPIO_MODE_OUTPUT);
+        }
+
+        /**
+         * @brief Enable the port clock and configure the pin as input
+         * @param pull Internal pull resistor configuration
+         */
+        static void configureInput(PinPull pull = PinPull::NO_PULL)
+        {
+            enableClock();
+            LL_GPIO_SetPinPull(port(), MASK, static_cast<uint32_t>(pull));
+            LL_GPIO_SetPinMode(port(), MASK, LL_GPIO_MODE_INPUT);
+        }
+
+        /**
+         * @brief Drive the pin HIGH (single BSRR store)
+         */
+        static void set() { port()->BSRR = MASK; }
+
+        /**
+         * @brief Drive the pin LOW (single BRR store)
+         */
+        static void reset() { port()->BRR = MASK; }
+
+        /**
+         * @brief Drive the pin to the given level (single BSRR store)
+         * @param state Logic level to write
+         */
+        static void write(PinState state)
+        {
+            port()->BSRR = (state == PinState::HIGH) ? MASK : (MASK << 16);
+        }
+
+        /**
+         * @brief Invert the output level
+         *
+         * Reads ODR once and writes BSRR once; other pins of the port are never
+         * touched, so this is safe against concurrent writes to the same port.
+         */
+        static void toggle()
+        {
+            const uint32_t odr = port()->ODR;
+            port()->BSRR = ((odr & MASK) << 16) | (~odr & MASK);
+        }
+
+        /**
+         * @brief Read the input level (single IDR load)
+         * @return Current pin level
+         */
+        static PinState read()
+        {
+            return static_cast<PinState>((port()->IDR & MASK) != 0);
+        }
+
+        /**
+         * @brief Check whether the pin reads HIGH
+         */
+        static bool isHigh() { return (port()->IDR & MASK) != 0; }
+
+        /**
+         * @brief Check whether the pin reads LOW
+         */
+        static bool isLow() { return (port()->IDR & MASK) == 0; }
+
+        /**
+         * @brief Read back the level the pin is driven to (ODR)
+         */
+        static PinState readOutput()
+        {
+            return static_cast<PinState>((port()->ODR & MASK) != 0);
+        }
+
+    private:
+        static void enableClock()
+        {
+            // GPIOx enable bits in AHB2ENR follow the port order, ports are 0x400 apart
+            LL_AHB2_GRP1_EnableClock(1UL << ((static_cast<uint32_t>(PORT) - GPIOA_BASE) >> 10));
+        }
+    };
+
+    /**
+     * @class PortGroup
+     * @brief Several pins of one port written and read as a single value
+     *
+     * A group is a pin mask on one port. Values are right-aligned: bit 0 of a value
+     * belongs to the lowest pin of the mask, and bits outside the (shifted) mask are
+     * ignored. For a contiguous mask such as PB8..PB15 (0xFF00) the value is the
+     * plain 8-bit bus word.
+     *
+     * write() sets and clears all pins of the group with one BSRR store, so they
+     * change in the same bus cycle and the other pins of the port are not touched.
+     * read() samples the whole group with one IDR load.
+     *
+     * @tparam PORT GPIO port
+     * @tparam MASK Pin mask (bit n = pin n), must not be empty
+     *
+     * @code
+     * using Bus = GPIO::PortGroup<GPIO::Port::B, 0xFF00>;   // D0..D7 on PB8..PB15
+     * Bus::configureOutput();
+     * Bus::write(0xA5);
+     * @endcode
+     */
+    template<Port PORT, uint32_t MASK>
+    class PortGroup
+    {
+        static_assert(MASK != 0 && MASK <= 0xFFFFUL, "Pin mask must select pins 0-15");
+
+    public:
+        static constexpr uint32_t SHIFT = static_cast<uint32_t>(__builtin_ctz(MASK));   ///< Lowest pin of the group
+        static constexpr uint32_t WIDTH = static_cast<uint32_t>(__builtin_popcount(MASK));
+        static constexpr uint32_t VALUE_MASK = MASK >> SHIFT;                          ///< Valid bits of a value
+
+        /**
+         * @brief Get the port registers
+         * @return Pointer to the GPIO port (constant address)
+         */
+        static GPIO_TypeDef* port() { return reinterpret_cast<GPIO_TypeDef*>(static_cast<uint32_t>(PORT)); }
+
+        /**
+         * @brief Enable the port clock and configure all pins of the group as outputs
+         * @param outputType Output driver type (PUSH_PULL or OPEN_DRAIN)
+         * @param speed Output speed/drive strength
+         * @note The pins are driven LOW before they are switched to output mode
+         */
+        static void configureOutput(PinOutputType outputType = PinOutputType::PUSH_PULL,
+                                    PinSpeed speed = PinSpeed::LOW)
+        {
+            enableClock();
+            port()->BRR = MASK;
+
+            LL_GPIO_InitTypeDef GPIO_InitStruct = {};
+            GPIO_InitStruct.Pin = MASK;
+            GPIO_InitStruct.Mode = LL_GPIO_MODE_OUTPUT;
+            GPIO_InitStruct.Speed = static_cast<uint32_t>(speed);
+            GPIO_InitStruct.OutputType = static_cast<uint32_t>(outputType);
+            GPIO_InitStruct.Pull = LL_GPIO_PULL_NO;
+            LL_GPIO_Init(port(), &GPIO_InitStruct);
+        }
+
+        /**
+         * @brief Enable the port clock and configure all pins of the group as inputs
+         * @param pull Internal pull resistor configuration
+         */
+        static void configureInput(PinPull pull = PinPull::NO_PULL)
+        {
+            enableClock();
+
+            LL_GPIO_InitTypeDef GPIO_InitStruct = {};
+            GPIO_InitStruct.Pin = MASK;
+            GPIO_InitStruct.Mode = LL_GPIO_MODE_INPUT;
+            GPIO_InitStruct.Pull = static_cast<uint32_t>(pull);
+            LL_GPIO_Init(port(), &GPIO_InitStruct);
+        }
+
+        /**
+         * @brief Drive the whole group to a value (single BSRR store)
+         * @param value Right-aligned group value
+         */
+        static void write(uint32_t value)
+        {
+            const uint32_t bits = (value << SHIFT) & MASK;
+            port()->BSRR = ((bits ^ MASK) << 16) | bits;
+        }
+
+        /**
+         * @brief Update only some pins of the group (single BSRR store)
+         *
+         * Pins outside @p select keep their level, without a read-modify-write of ODR.
+         *
+         * @param value Right-aligned values for the selected pins
+         * @param select Right-aligned mask of the pins to update
+         */
+        static void writeMasked(uint32_t value, uint32_t select)
+        {
+            const uint32_t update = (select << SHIFT) & MASK;
+            const uint32_t bits = (value << SHIFT) & update;
+            port()->BSRR = ((bits ^ update) << 16) | bits;
+        }
+
+        /**
+         * @brief Drive the selected pins HIGH (single BSRR store)
+         * @param select Right-aligned mask of the pins, all pins by default
+         */
+        static void set(uint32_t select = VALUE_MASK) { port()->BSRR = (select << SHIFT) & MASK; }
+
+        /**
+         * @brief Drive the selected pins LOW (single BRR store)
+         * @param select Right-aligned mask of the pins, all pins by default
+         */
+        static void reset(uint32_t select = VALUE_MASK) { port()->BRR = (select << SHIFT) & MASK; }
+
+        /**
+         * @brief Invert the selected pins (one ODR read, one BSRR store)
+         * @param select Right-aligned mask of the pins, all pins by default
+         */
+        static void toggle(uint32_t select = VALUE_MASK)
+        {
+            const uint32_t update = (select << SHIFT) & MASK;
+            const uint32_t odr = port()->ODR;
+            port()->BSRR = ((odr & update) << 16) | (~odr & update);
+        }
+
+        /**
+         * @brief Sample the whole group (single IDR load)
+         * @return Right-aligned group value
+         */
+        static uint32_t read() { return (port()->IDR & MASK) >> SHIFT; }
+
+        /**
+         * @brief Read back the value the group is driven to (ODR)
+         * @return Right-aligned group value
+         */
+        static uint32_t readOutput() { return (port()->ODR & MASK) >> SHIFT; }
+
+    private:
+        static void enableClock()
+        {
+            LL_AHB2_GRP1_EnableClock(1UL << ((static_cast<uint32_t>(PORT) - GPIOA_BASE) >> 10));
+        }
+    };
+
 } // namespace GPIO
 
 #endif /* DEVICE_INC_GPIO_H_ */
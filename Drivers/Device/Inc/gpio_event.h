@@ -0,0 +1,171 @@
+/**
+ * @file gpio_event.h
+ * @brief Deferred GPIO event queue: EXTI ISRs post, the main loop handles
+ *
+ * A GPIOEXTI pin attached to a PinEventQueue posts one small PinEvent (pin,
+ * edge, cycle timestamp) per interrupt instead of running user code in the ISR.
+ * Timestamps come from the SysTick time base (TIME::nowCycles32()), which keeps
+ * counting while the main loop sleeps in WFI.
+ * The main loop drains the queue in batches with process().
+ *
+ * Posting is lock-free and safe from EXTI handlers of any priority: a slot is
+ * claimed with LDREX/STREX and published by writing its sequence number. The
+ * consumer (one context, normally the main loop) only reads slots whose
+ * sequence matches, so a slot being filled by a preempted ISR is never read early.
+ *
+ * @note When the queue is full the event is dropped, counted, and its pin is
+ *       recorded in a sticky overflow mask, so a bouncing button is never lost
+ *       silently: the handler can re-read the pin level for pins in that mask.
+ */
+
+#ifndef DEVICE_INC_GPIO_EVENT_H_
+#define DEVICE_INC_GPIO_EVENT_H_
+
+#include "main.h"
+#include "SystemTime.h"
+
+#include <cstdint>
+
+#ifndef GPIO_EVENT_QUEUE_SIZE
+#define GPIO_EVENT_QUEUE_SIZE 32U   // Events buffered between ISRs and the main loop (power of 2)
+#endif
+
+#ifndef GPIO_EVENT_BATCH_SIZE
+#define GPIO_EVENT_BATCH_SIZE 8U    // Events handed to the handler per call of process()
+#endif
+
+namespace GPIO
+{
+    /**
+     * @enum Edge
+     * @brief Direction of the transition that raised an event
+     */
+    enum class Edge : uint8_t
+    {
+        FALLING = 0,   ///< HIGH to LOW
+        RISING = 1     ///< LOW to HIGH
+    };
+
+    /**
+     * @struct PinEvent
+     * @brief One EXTI edge as recorded in interrupt context
+     */
+    struct PinEvent
+    {
+        uint32_t timestamp;   ///< TIME::nowCycles32() at ISR entry
+        uint8_t pin;          ///< Pin / EXTI line number (0-15)
+        Edge edge;            ///< Edge direction
+    };
+
+    /**
+     * @class PinEventQueue
+     * @brief Lock-free multi-producer, single-consumer queue of PinEvents
+     */
+    class PinEventQueue
+    {
+    public:
+        /**
+         * @brief Batch handler called from process()
+         * @param events Events in the order they were posted
+         * @param count Number of events (1..GPIO_EVENT_BATCH_SIZE)
+         * @param context Pointer given to process()
+         */
+        using BatchHandler = void (*)(const PinEvent* events, uint32_t count, void* context);
+
+        /**
+         * @brief Record an edge on a pin, timestamped now (interrupt context)
+         * @param pin Pin number (0-15)
+         * @param edge Edge direction
+         * @return false if the queue was full and the event was dropped
+         */
+        bool post(uint32_t pin, Edge edge)
+        {
+            return post(pin, edge, TIME::nowCycles32());
+        }
+
+        /**
+         * @brief Record an edge on a pin with a timestamp taken earlier (interrupt context)
+         * @param pin Pin number (0-15)
+         * @param edge Edge direction
+         * @param timestamp TIME::nowCycles32(), normally taken at ISR entry
+         * @return false if the queue was full and the event was dropped
+         */
+        bool post(uint32_t pin, Edge edge, uint32_t timestamp)
+        {
+            uint32_t position;
+
+            do {
+                position = __LDREXW(&head_);
+                if (position - tail_ >= GPIO_EVENT_QUEUE_SIZE) {
+                    __CLREX();
+                    recordOverflow(pin);
+                    return false;
+                }
+            } while (__STREXW(position + 1U, &head_) != 0);
+
+            Slot& slot = slots_[position & MASK];
+            slot.event.timestamp = timestamp;
+            slot.event.pin = static_cast<uint8_t>(pin);
+            slot.event.edge = edge;
+            __DMB();    // Event visible before its sequence number
+            slot.sequence = position + 1U;
+            return true;
+        }
+
+        /**
+         * @brief Remove up to @p maxCount events
+         * @param events Destination array
+         * @param maxCount Capacity of @p events
+         * @return Number of events copied
+         * @note Single consumer only
+         */
+        uint32_t drain(PinEvent* events, uint32_t maxCount);
+
+        /**
+         * @brief Hand all queued events to a handler in batches
+         * @param handler Called once per batch of up to GPIO_EVENT_BATCH_SIZE events
+         * @param context Pointer passed through to the handler
+         * @return Number of events processed
+         * @note Single consumer only, normally the main loop
+         */
+        uint32_t process(BatchHandler handler, void* context = nullptr);
+
+        /**
+         * @brief Check whether events are waiting
+         */
+        bool isEmpty() const { return head_ == tail_; }
+
+        /**
+         * @brief Number of events dropped because the queue was full
+         */
+        uint32_t getDropped() const { return dropped_; }
+
+        /**
+         * @brief Read and clear the mask of pins that lost events (bit n = pin n)
+         */
+        uint32_t takeOverflowPins();
+
+    private:
+        static_assert((GPIO_EVENT_QUEUE_SIZE & (GPIO_EVENT_QUEUE_SIZE - 1U)) == 0,
+                      "GPIO_EVENT_QUEUE_SIZE must be a power of 2");
+
+        static constexpr uint32_t MASK = GPIO_EVENT_QUEUE_SIZE - 1U;
+
+        struct Slot
+        {
+            volatile uint32_t sequence;   ///< Position + 1 once the event is complete
+            PinEvent event;
+        };
+
+        Slot slots_[GPIO_EVENT_QUEUE_SIZE] = {};
+        volatile uint32_t head_ = 0;            ///< Free-running claim counter (producers)
+        volatile uint32_t tail_ = 0;            ///< Free-running consume counter (consumer)
+        volatile uint32_t dropped_ = 0;
+        volatile uint32_t overflowPins_ = 0;
+
+        void recordOverflow(uint32_t pin);
+    };
+
+} // namespace GPIO
+
+#endif /* DEVICE_INC_GPIO_EVENT_H_ */
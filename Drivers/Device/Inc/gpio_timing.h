@@ -0,0 +1,135 @@
+/**
+ * @file gpio_timing.h
+ * @brief Cycle-accurate edge history for GPIOEXTI pins
+ *
+ * An EdgeTimer attached to a GPIOEXTI records the cycle time taken at ISR entry
+ * (TIME::nowCycles32(), the SysTick time base) together with the edge direction
+ * for the last GPIO_EDGE_HISTORY_SIZE edges. Pulse width, period and frequency
+ * are computed from that history in thread mode, with a resolution of one core
+ * clock cycle (31.25 ns at 32 MHz) and no timer peripheral. Unlike the DWT
+ * cycle counter, SysTick keeps counting in Sleep, so intervals that span the
+ * event loop's WFI are measured in full.
+ *
+ * @code
+ * static GPIO::EdgeTimer timer;
+ * input->setTrigger(GPIO::EXTITrigger::RISING_FALLING);
+ * input->setEdgeTimer(&timer);
+ * input->enableInterrupt();
+ * ...
+ * uint32_t high;
+ * if (timer.getPulseWidth(GPIO::PinState::HIGH, high)) { ... TIME::cyclesToNs(high) ... }
+ * @endcode
+ *
+ * @note Intervals must be shorter than 2^32 cycles (about 134 s at 32 MHz).
+ *       Accuracy is limited by interrupt latency jitter, not by the counter;
+ *       each tickless sleep inside an interval loses a few cycles (SystemTime.h).
+ */
+
+#ifndef DEVICE_INC_GPIO_TIMING_H_
+#define DEVICE_INC_GPIO_TIMING_H_
+
+#include "main.h"
+#include "gpio.h"
+#include "gpio_event.h"
+
+#include <cstdint>
+
+#ifndef GPIO_EDGE_HISTORY_SIZE
+#define GPIO_EDGE_HISTORY_SIZE 8U   // Edges kept per EdgeTimer (power of 2, at least 4)
+#endif
+
+namespace GPIO
+{
+    /**
+     * @struct EdgeSample
+     * @brief One recorded edge
+     */
+    struct EdgeSample
+    {
+        uint32_t timestamp;   ///< TIME::nowCycles32() at ISR entry
+        Edge edge;            ///< Edge direction
+    };
+
+    /**
+     * @class EdgeTimer
+     * @brief Ring of the most recent edges of one pin with timing queries
+     *
+     * Written by one ISR, read from thread mode. Readers take a consistent
+     * snapshot and retry if an edge was recorded while they copied.
+     */
+    class EdgeTimer
+    {
+    public:
+        /**
+         * @brief Record an edge (interrupt context)
+         * @param timestamp Cycle count taken at ISR entry
+         * @param edge Edge direction
+         */
+        void record(uint32_t timestamp, Edge edge)
+        {
+            const uint32_t position = count_;
+            samples_[position & MASK].timestamp = timestamp;
+            samples_[position & MASK].edge = edge;
+            __DMB();    // Sample visible before the count
+            count_ = position + 1U;
+        }
+
+        /**
+         * @brief Copy the most recent edges, oldest first
+         * @param samples Destination array
+         * @param maxCount Capacity of @p samples (at most GPIO_EDGE_HISTORY_SIZE used)
+         * @return Number of edges copied, 0 if the history is empty or kept changing
+         */
+        uint32_t getHistory(EdgeSample* samples, uint32_t maxCount) const;
+
+        /**
+         * @brief Duration of the last complete pulse at a level
+         * @param level HIGH: last rising to following falling edge, LOW: falling to rising
+         * @param cycles Pulse width in core clock cycles
+         * @return false if no complete pulse is in the history
+         * @note Requires the RISING_FALLING trigger
+         */
+        bool getPulseWidth(PinState level, uint32_t& cycles) const;
+
+        /**
+         * @brief Average period over the last @p edges edges of the history
+         *
+         * Uses the edges of the same direction as the newest one, so it works with
+         * single-edge and RISING_FALLING triggers alike.
+         *
+         * @param cycles Average period in core clock cycles
+         * @param edges Number of most recent edges to consider (2..GPIO_EDGE_HISTORY_SIZE)
+         * @return false if fewer than two edges of one direction are available
+         */
+        bool getPeriod(uint32_t& cycles, uint32_t edges = GPIO_EDGE_HISTORY_SIZE) const;
+
+        /**
+         * @brief Signal frequency derived from getPeriod()
+         * @param edges Number of most recent edges to consider
+         * @return Frequency in Hz, 0 if no period is available
+         */
+        float getFrequency(uint32_t edges = GPIO_EDGE_HISTORY_SIZE) const;
+
+        /**
+         * @brief Total number of edges recorded since construction or clear()
+         */
+        uint32_t getEdgeCount() const { return count_; }
+
+        /**
+         * @brief Forget all recorded edges
+         */
+        void clear() { count_ = 0; }
+
+    private:
+        static_assert((GPIO_EDGE_HISTORY_SIZE & (GPIO_EDGE_HISTORY_SIZE - 1U)) == 0 && GPIO_EDGE_HISTORY_SIZE >= 4U,
+                      "GPIO_EDGE_HISTORY_SIZE must be a power of 2, at least 4");
+
+        static constexpr uint32_t MASK = GPIO_EDGE_HISTORY_SIZE - 1U;
+
+        EdgeSample samples_[GPIO_EDGE_HISTORY_SIZE] = {};
+        volatile uint32_t count_ = 0;   ///< Edges recorded (free running)
+    };
+
+} // namespace GPIO
+
+#endif /* DEVICE_INC_GPIO_TIMING_H_ */
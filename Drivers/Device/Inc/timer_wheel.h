@@ -0,0 +1,209 @@
+/**
+ * @file timer_wheel.h
+ * @brief Tickless hierarchical timer wheel driven by TIM7
+ *
+ * Software timers (one-shot and periodic) live in a 4-level timing wheel of 64
+ * slots per level, each level 64 times coarser than the one below:
+ *
+ * | Level | Slot width | Range        (1 ms ticks) |
+ * |-------|------------|---------------------------|
+ * | 0     | 1 tick     | 64 ms                     |
+ * | 1     | 64         | 4.1 s                     |
+ * | 2     | 4096       | 4.4 min                   |
+ * | 3     | 262144     | 4.7 h (longer: re-queued) |
+ *
+ * Timers are intrusive doubly linked list nodes, so start() and stop() are O(1)
+ * no matter how many timers exist. A 64-bit occupancy mask per level finds the
+ * next non-empty slot with one count-trailing-zeros, so the wheel never walks
+ * empty ticks: TIM7 runs in one-pulse mode and is programmed for the next expiry
+ * (or slot cascade) only. With no timers armed TIM7 is stopped.
+ *
+ * Wheel time is derived from TIME::nowUs() (SystemTime.h), so TIM7 rounding
+ * never accumulates drift; periodic timers are re-armed from their previous
+ * deadline, not from the moment the callback ran.
+ *
+ * Callbacks run either in the TIM7 interrupt (Context::INTERRUPT) or are queued
+ * and run from thread mode by runDeferred() (Context::THREAD).
+ */
+
+#ifndef DEVICE_INC_TIMER_WHEEL_H_
+#define DEVICE_INC_TIMER_WHEEL_H_
+
+#include "main.h"
+
+#include <cstdint>
+
+#ifndef TIMER_WHEEL_TICK_US
+#define TIMER_WHEEL_TICK_US 1000U   // Wheel resolution (multiple of 100 us)
+#endif
+
+/**
+ * @namespace TIMER
+ * @brief Software timers on the TIM7 basic timer
+ */
+namespace TIMER
+{
+    class TimerWheel;
+
+    /**
+     * @enum Context
+     * @brief Where a timer callback runs
+     */
+    enum class Context : uint8_t
+    {
+        INTERRUPT,   ///< Directly in the TIM7 interrupt - keep it short
+        THREAD       ///< Queued, run by TimerWheel::runDeferred() in the main loop
+    };
+
+    /**
+     * @class Timer
+     * @brief One software timer; owns no memory beyond itself
+     *
+     * @warning A Timer must stay alive (and must not move) while it is armed.
+     */
+    class Timer
+    {
+    public:
+        using Callback = void (*)(void* context);   ///< Expiry callback
+
+        /**
+         * @brief Construct an idle timer
+         * @param callback Function called on expiry
+         * @param context Pointer passed to the callback
+         * @param where Interrupt or thread-mode execution of the callback
+         */
+        Timer(Callback callback, void* context = nullptr, Context where = Context::INTERRUPT)
+            : callback_(callback), context_(context), where_(where) {}
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        /**
+         * @brief Check whether the timer is armed
+         */
+        bool isActive() const { return list_ != NO_LIST; }
+
+        /**
+         * @brief Number of periods skipped or coalesced because the callback ran late
+         */
+        uint32_t getOverruns() const { return overruns_; }
+
+    private:
+        friend class TimerWheel;
+
+        static constexpr uint16_t NO_LIST = 0xFFFFU;
+
+        Timer* next_ = nullptr;            ///< Wheel slot list
+        Timer* prev_ = nullptr;
+        Timer* deferredNext_ = nullptr;    ///< Thread-mode run queue
+        uint32_t expires_ = 0;             ///< Absolute tick of the next expiry
+        uint32_t period_ = 0;              ///< Ticks between expiries, 0 = one-shot
+        uint32_t overruns_ = 0;
+        Callback callback_;
+        void* context_;
+        volatile uint16_t list_ = NO_LIST; ///< Index of the list the timer is on
+        volatile bool deferred_ = false;   ///< Queued for runDeferred()
+        Context where_;
+    };
+
+    /**
+     * @class TimerWheel
+     * @brief Hierarchical timing wheel; one instance owns TIM7
+     */
+    class TimerWheel
+    {
+    public:
+        TimerWheel() = default;
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        /**
+         * @brief Configure TIM7 and bind this wheel to its interrupt
+         * @note The time base (TIME::init) must be running
+         */
+        void begin();
+
+        /**
+         * @brief Arm a one-shot timer (restarts it if armed)
+         * @param timer Timer to arm
+         * @param delayTicks Ticks until expiry (0 = next tick)
+         */
+        void startOneShot(Timer& timer, uint32_t delayTicks);
+
+        /**
+         * @brief Arm a periodic timer (restarts it if armed)
+         * @param timer Timer to arm
+         * @param periodTicks Ticks between expiries (at least 1)
+         * @param firstDelayTicks Ticks until the first expiry
+         */
+        void startPeriodic(Timer& timer, uint32_t periodTicks, uint32_t firstDelayTicks);
+        void startPeriodic(Timer& timer, uint32_t periodTicks) { startPeriodic(timer, periodTicks, periodTicks); }
+
+        /**
+         * @brief Disarm a timer and drop a queued thread-mode run
+         * @param timer Timer to stop; stopping an idle timer is harmless
+         */
+        void stop(Timer& timer);
+
+        /**
+         * @brief Run queued Context::THREAD callbacks
+         * @return Number of callbacks run
+         * @note Call from the main loop only
+         */
+        uint32_t runDeferred();
+
+        /**
+         * @brief Check whether thread-mode callbacks are waiting
+         */
+        bool hasDeferred() const { return deferredHead_ != nullptr; }
+
+        /**
+         * @brief Current wheel time in ticks (wraps after 2^32 ticks)
+         */
+        static uint32_t now();
+
+        /**
+         * @brief Convert milliseconds to wheel ticks, rounded up
+         */
+        static constexpr uint32_t msToTicks(uint32_t ms) {
+            return (ms * 1000U + TIMER_WHEEL_TICK_US - 1U) / TIMER_WHEEL_TICK_US;
+        }
+
+        /**
+         * @brief TIM7 interrupt handler, forwards to the bound wheel
+         * @note Call this from TIM7_IRQHandler
+         */
+        static void handleInterrupt();
+
+    private:
+        static constexpr uint32_t LEVELS = 4;
+        static constexpr uint32_t SLOT_BITS = 6;
+        static constexpr uint32_t SLOTS = 1UL << SLOT_BITS;
+        static constexpr uint32_t SLOT_MASK = SLOTS - 1U;
+        static constexpr uint32_t MAX_DELTA = (1UL << (LEVELS * SLOT_BITS)) - 1U;
+        static constexpr uint16_t EXPIRED_LIST = LEVELS * SLOTS;   ///< Due, callbacks not yet run
+        static constexpr uint32_t MAX_DELAY = 0x7FFFFFFFUL;        ///< Tick arithmetic is modulo 2^32
+
+        Timer* lists_[LEVELS * SLOTS + 1] = {};
+        uint64_t occupied_[LEVELS] = {};    ///< Bit n = slot n of the level is non-empty
+        uint32_t current_ = 0;              ///< Last processed tick
+        Timer* deferredHead_ = nullptr;
+        Timer* deferredTail_ = nullptr;
+
+        void arm(Timer& timer, uint32_t delayTicks, uint32_t periodTicks);
+        void insert(Timer& timer);
+        void push(Timer& timer, uint16_t list);
+        void unlink(Timer& timer);
+        void removeDeferred(Timer& timer);
+        bool nextEvent(uint32_t& delta) const;
+        void catchUp();
+        void collect(uint32_t tick);
+        void runExpired();
+        void advance(uint32_t target);
+        void schedule();
+        void serve();
+    };
+
+} // namespace TIMER
+
+#endif /* DEVICE_INC_TIMER_WHEEL_H_ */
@@ -11,14 +11,15 @@
 #include "main.h"
 #include <cstring>
 #include <cstdarg>
-#include <cstdio>
 #include <cstdint>
 
 // C interface for interrupt handlers
 #ifdef __cplusplus
 extern "C" {
 #endif
-    void USART_HandleLpuart1Interrupt(void);
+    void USART_HandleInterrupt(uint32_t peripheral);
+    void USART_HandleDmaTxInterrupt(uint32_t peripheral);
+    void USART_HandleDmaRxInterrupt(uint32_t peripheral);
 #ifdef __cplusplus
 }
 #endif
@@ -31,12 +32,24 @@ namespace USART
 {
     /**
      * @brief USART peripheral type enumeration
+     * @note Values index the interrupt dispatch table and are used by the C ISRs
      */
     enum class PeripheralType {
-        USART_1,
-        USART_2, 
-        USART_3,
-        LPUART_1
+        USART_1 = 0,
+        USART_2 = 1, 
+        USART_3 = 2,
+        LPUART_1 = 3
+    };
+
+    /// Number of peripherals served by the interrupt dispatch table
+    constexpr uint32_t PERIPHERAL_COUNT = 4;
+
+    /**
+     * @brief Transmit engine selection
+     */
+    enum class TransferMode {
+        INTERRUPT,  ///< One TXE interrupt per byte
+        DMA         ///< One DMA transfer per contiguous buffer region
     };
 
     /**
@@ -49,6 +62,7 @@ namespace USART
         uint32_t parity;
         uint32_t hwFlowControl;
         uint32_t transferDirection;
+        TransferMode txMode;
     };
 
     /**
@@ -95,6 +109,100 @@ namespace USART
             return true;
         }
 
+        /**
+         * @brief Put a block of data into buffer
+         * @param data Source data
+         * @param length Number of bytes to put
+         * @return Number of bytes actually stored (limited by free space)
+         * @note Copies in at most two segments and publishes head once
+         */
+        uint16_t write(const uint8_t* data, uint16_t length) {
+            const uint16_t currentHead = head;
+            const uint16_t free = (tail - currentHead - 1) & MASK;
+            if (length > free) {
+                length = free;
+            }
+
+            const uint16_t first = (length < SIZE - currentHead) ? length : (SIZE - currentHead);
+            memcpy(&buffer[currentHead], data, first);
+            memcpy(&buffer[0], data + first, length - first);
+
+            __DMB(); // Data must be visible before the consumer sees the new head
+            head = (currentHead + length) & MASK;
+            return length;
+        }
+
+        /**
+         * @brief Get a block of data from buffer
+         * @param data Destination buffer
+         * @param length Maximum number of bytes to get
+         * @return Number of bytes actually retrieved
+         * @note Copies in at most two segments and releases tail once
+         */
+        uint16_t read(uint8_t* data, uint16_t length) {
+            const uint16_t currentTail = tail;
+            const uint16_t used = (head - currentTail) & MASK;
+            if (length > used) {
+                length = used;
+            }
+
+            const uint16_t first = (length < SIZE - currentTail) ? length : (SIZE - currentTail);
+            memcpy(data, &buffer[currentTail], first);
+            memcpy(data + first, &buffer[0], length - first);
+
+            __DMB(); // Finish reading before the producer may overwrite the bytes
+            tail = (currentTail + length) & MASK;
+            return length;
+        }
+
+        /**
+         * @brief Get the largest contiguous writable region
+         * @param data Set to the start of the region
+         * @return Number of bytes writable at data without wrapping
+         * @note Producer side only; make the bytes visible with publish()
+         */
+        uint16_t reserveContiguous(uint8_t*& data) {
+            const uint16_t currentHead = head;
+            const uint16_t free = (tail - currentHead - 1) & MASK;
+            const uint16_t toEnd = SIZE - currentHead;
+            data = &buffer[currentHead];
+            return (free < toEnd) ? free : toEnd;
+        }
+
+        /**
+         * @brief Publish bytes written into a region from reserveContiguous()
+         * @param count Number of bytes written
+         */
+        void publish(uint16_t count) {
+            __DMB();
+            head = (head + count) & MASK;
+        }
+
+        /**
+         * @brief Get the largest contiguous readable region
+         * @param data Set to the start of the region
+         * @return Number of bytes readable at data without wrapping
+         * @note Consumer side only; release the bytes with commit()
+         */
+        uint16_t peekContiguous(const uint8_t*& data) const {
+            uint16_t currentHead = head;
+            uint16_t currentTail = tail;
+            data = &buffer[currentTail];
+            if (currentHead >= currentTail) {
+                return currentHead - currentTail;
+            }
+            return SIZE - currentTail;
+        }
+
+        /**
+         * @brief Release bytes previously obtained with peekContiguous()
+         * @param count Number of bytes consumed
+         */
+        void commit(uint16_t count) {
+            __DMB();
+            tail = (tail + count) & MASK;
+        }
+
         /**
          * @brief Check if buffer is empty
          */
@@ -138,19 +246,50 @@ namespace USART
      */
     template<uint16_t BUFFER_SIZE = 256>
     class UsartDriver {
+    public:
+        /**
+         * @brief Most bytes the TX queue holds at once (one slot stays free)
+         */
+        static constexpr uint16_t TX_CAPACITY = BUFFER_SIZE - 1;
+
+        /**
+         * @brief Notification from interrupt context (TX idle, RX data)
+         */
+        using EventCallback = void (*)(void* context);
+
     private:
         PeripheralType peripheralType;
         void* usartInstance; // Will point to USART_TypeDef* or USART_TypeDef* 
         Config config;
         CircularBuffer<BUFFER_SIZE> txBuffer;
         volatile bool transmissionActive;
+        volatile uint16_t dmaTxLength;  // Bytes handed to the TX DMA channel
+
+        // RX: circular DMA target, positions are free-running byte counts
+        uint8_t rxBuffer[BUFFER_SIZE];
+        volatile uint32_t rxWritten;    // Bytes written by DMA (updated on IDLE/HT/TC)
+        uint32_t rxRead;                // Bytes consumed by receive()
+        volatile uint16_t rxDmaPosition; // Last observed DMA write index
+        volatile uint32_t rxOverruns;   // Bytes lost because the buffer wrapped
+        volatile uint32_t rxErrors;     // Framing/noise/overrun errors reported by the peripheral
+
+        // Notifications, called from the USART/DMA interrupts
+        EventCallback txIdleCallback;
+        void* txIdleContext;
+        EventCallback rxCallback;
+        void* rxContext;
         
         // Private methods for hardware abstraction
         void initializeLpuart();
-        void initializeUsart();
+        bool initializeUsart();
+        void initializeTxDma();
+        void initializeRxDma();
+        void bindInterrupts();
+        void updateRxPosition();
         void enableTxInterrupt();
         void disableTxInterrupt();
         void transmitByte(uint8_t data);
+        void transmitNextDmaRegion();
         bool isTxReady();
         
     public:
@@ -160,10 +299,18 @@ namespace USART
          */
         explicit UsartDriver(PeripheralType peripheral);
 
+        /**
+         * @brief Destructor - removes this instance from the interrupt dispatch table
+         */
+        ~UsartDriver();
+
+        UsartDriver(const UsartDriver&) = delete;
+        UsartDriver& operator=(const UsartDriver&) = delete;
+
         /**
          * @brief Initialize USART with configuration
          * @param cfg Configuration structure
-         * @return true if successful
+         * @return true if successful, false if the baud rate cannot be generated
          */
         bool initialize(const Config& cfg);
 
@@ -214,6 +361,35 @@ namespace USART
          */
         uint16_t sendBinary(const uint8_t* data, uint16_t length);
 
+        /**
+         * @brief Receive buffered data (non-blocking)
+         * @param data Destination buffer
+         * @param maxLength Capacity of the destination buffer
+         * @return Number of bytes copied (0 if nothing was received)
+         * @note If the DMA overtook the reader, the oldest data is dropped
+         *       and counted in getRxOverruns()
+         */
+        uint16_t receive(uint8_t* data, uint16_t maxLength);
+
+        /**
+         * @brief Get number of received bytes waiting in the RX buffer
+         */
+        uint16_t getRxLevel();
+
+        /**
+         * @brief Get number of bytes dropped because the RX buffer was not drained in time
+         */
+        uint32_t getRxOverruns() const {
+            return rxOverruns;
+        }
+
+        /**
+         * @brief Get number of framing, noise and overrun errors seen by the peripheral
+         */
+        uint32_t getRxErrors() const {
+            return rxErrors;
+        }
+
         /**
          * @brief Check if transmission is active
          */
@@ -221,6 +397,21 @@ namespace USART
             return transmissionActive;
         }
 
+        /**
+         * @brief Set the callback run when the TX queue has been sent completely
+         * @param callback Called from interrupt context, nullptr to remove
+         * @param context Pointer passed to the callback
+         */
+        void setTxIdleCallback(EventCallback callback, void* context = nullptr);
+
+        /**
+         * @brief Set the callback run when received bytes have been accounted
+         * @details Called on the idle line and on DMA half/full transfer.
+         * @param callback Called from interrupt context, nullptr to remove
+         * @param context Pointer passed to the callback
+         */
+        void setRxCallback(EventCallback callback, void* context = nullptr);
+
         /**
          * @brief Get available buffer space
          */
@@ -252,6 +443,30 @@ namespace USART
          */
         void handleTxCompleteInterrupt();
 
+        /**
+         * @brief Handle USART/LPUART peripheral interrupt
+         */
+        void handleInterrupt();
+
+        /**
+         * @brief Handle TX DMA channel interrupt
+         * @details Releases the transferred region and re-arms the channel
+         *          with the next contiguous region, if any.
+         */
+        void handleDmaTxInterrupt();
+
+        /**
+         * @brief Handle RX DMA channel interrupt (half and full transfer)
+         */
+        void handleDmaRxInterrupt();
+
+        /**
+         * @brief Get transmit engine in use
+         */
+        TransferMode getTransferMode() const {
+            return config.txMode;
+        }
+
         /**
          * @brief Get peripheral type
          */
@@ -283,17 +498,21 @@ namespace USART
     Config getDefaultUsartConfig();
 
     /**
-     * @brief Register LPUART1 interrupt handler
+     * @brief Dispatch a USART/LPUART interrupt to the driver bound to the peripheral
+     * @param peripheral Peripheral whose IRQ fired
+     * @note O(1): one table lookup and one indirect call, valid for every buffer size
      */
-    void registerLpuart1Handler(void* instance);
+    void handleInterrupt(PeripheralType peripheral);
 
     /**
-     * @brief Handle LPUART1 interrupt
+     * @brief Dispatch a TX DMA channel interrupt to the driver bound to the peripheral
      */
-    void handleLpuart1Interrupt();
+    void handleDmaTxInterrupt(PeripheralType peripheral);
 
-    // Global interrupt handlers and instance management
-    extern "C" void USART_HandleLpuart1Interrupt(void);
+    /**
+     * @brief Dispatch an RX DMA channel interrupt to the driver bound to the peripheral
+     */
+    void handleDmaRxInterrupt(PeripheralType peripheral);
 
 } // namespace USART
 
@@ -308,6 +527,7 @@ typedef struct {
     uint32_t wordLength;
     uint32_t stopBits;
     uint32_t parity;
+    uint32_t useDma;
 } USART_Config;
 
 // C interface functions
@@ -315,6 +535,7 @@ void* USART_CreateDebugInstance(void);
 void* USART_GetDefaultLpuartConfig(void);
 void USART_Initialize(void* instance, void* config);
 void USART_SendChar(void* instance, char c);
+int USART_Receive(void* instance, char* buffer, int length);
 
 #ifdef __cplusplus
 }
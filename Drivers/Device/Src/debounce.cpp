@@ -0,0 +1,204 @@
+/**
+ * @file debounce.cpp
+ * @brief Implementation of the timer-sampled vertical-counter debouncer
+ *
+ * @see debounce.h for the counter equations
+ */
+
+#include "debounce.h"
+
+namespace GPIO
+{
+//=============================================================================
+// Debouncer Implementation
+//=============================================================================
+
+/**
+ * @brief Construct a debouncer posting to a queue
+ *
+ * @param queue Queue receiving one event per debounced press/release
+ */
+Debouncer::Debouncer(PinEventQueue& queue)
+    : queue_(queue), timer_(onTimer, this)
+{
+}
+
+/**
+ * @brief Stop sampling
+ */
+Debouncer::~Debouncer()
+{
+    stop();
+}
+
+/**
+ * @brief Add a pin to the debounced set
+ *
+ * The timer interrupt is masked while the port state is updated.
+ *
+ * @param port GPIO port
+ * @param pin Pin number (0-15)
+ * @return false if the pin number is invalid or used on another port
+ */
+bool Debouncer::watch(GPIO_TypeDef* port, uint32_t pin)
+{
+    const uint32_t index = getPortIndex(port);
+    if (pin >= 16 || index >= PORT_COUNT) {
+        return false;
+    }
+
+    const uint32_t bit = 1UL << pin;
+    PortState& portState = ports_[index];
+    if ((watchedLines_ & bit) && !(portState.mask & bit)) {
+        return false; // Pin number already watched on another port
+    }
+
+    const bool running = (wheel_ != nullptr);
+    if (running) {
+        NVIC_DisableIRQ(TIM7_IRQn);
+    }
+    portState.state = (portState.state & ~bit) | (LL_GPIO_ReadInputPort(port) & bit);
+    portState.count0 &= ~bit;
+    portState.count1 &= ~bit;
+    portState.mask |= bit;
+    watchedLines_ |= bit;
+    if (running) {
+        NVIC_EnableIRQ(TIM7_IRQn);
+    }
+    return true;
+}
+
+/**
+ * @brief Remove a pin from the debounced set
+ *
+ * @param port GPIO port
+ * @param pin Pin number (0-15)
+ */
+void Debouncer::unwatch(GPIO_TypeDef* port, uint32_t pin)
+{
+    const uint32_t index = getPortIndex(port);
+    if (pin >= 16 || index >= PORT_COUNT) {
+        return;
+    }
+
+    const uint32_t bit = 1UL << pin;
+    const bool running = (wheel_ != nullptr);
+    if (running) {
+        NVIC_DisableIRQ(TIM7_IRQn);
+    }
+    if (ports_[index].mask & bit) {
+        ports_[index].mask &= ~bit;
+        watchedLines_ &= ~bit;
+    }
+    if (running) {
+        NVIC_EnableIRQ(TIM7_IRQn);
+    }
+}
+
+/**
+ * @brief Sample periodically from the timer wheel interrupt
+ *
+ * @param wheel Running timer wheel
+ * @param periodMs Sample period in milliseconds
+ */
+void Debouncer::start(TIMER::TimerWheel& wheel, uint32_t periodMs)
+{
+    stop();
+    wheel_ = &wheel;
+    wheel.startPeriodic(timer_, TIMER::TimerWheel::msToTicks(periodMs));
+}
+
+/**
+ * @brief Stop sampling
+ */
+void Debouncer::stop()
+{
+    if (wheel_) {
+        wheel_->stop(timer_);
+        wheel_ = nullptr;
+    }
+}
+
+/**
+ * @brief Get the debounced level of a pin
+ *
+ * @param port GPIO port
+ * @param pin Pin number (0-15)
+ * @return Debounced level, LOW for pins that are not watched
+ */
+PinState Debouncer::getState(GPIO_TypeDef* port, uint32_t pin) const
+{
+    const uint32_t index = getPortIndex(port);
+    if (pin >= 16 || index >= PORT_COUNT) {
+        return PinState::LOW;
+    }
+    const PortState& portState = ports_[index];
+    return static_cast<PinState>((portState.state & portState.mask & (1UL << pin)) != 0);
+}
+
+/**
+ * @brief Run the vertical counters of all watched ports once
+ *
+ * One IDR read per port; every pin whose debounced state flips is posted as
+ * an event, lowest pin first.
+ */
+void Debouncer::sample()
+{
+    for (uint32_t index = 0; index < PORT_COUNT; index++) {
+        PortState& portState = ports_[index];
+        if (portState.mask == 0) {
+            continue;
+        }
+
+        const uint32_t sample = LL_GPIO_ReadInputPort(getPort(index));
+        const uint32_t delta = (sample ^ portState.state) & portState.mask;
+        portState.count1 = (portState.count1 ^ portState.count0) & delta;
+        portState.count0 = ~portState.count0 & delta;
+        const uint32_t toggle = delta & ~(portState.count0 | portState.count1);
+        if (toggle == 0) {
+            continue;
+        }
+        portState.state ^= toggle;
+
+        uint32_t changed = __RBIT(toggle);
+        while (changed != 0) {
+            const uint32_t pin = __CLZ(changed);
+            changed &= ~(0x80000000UL >> pin);
+            queue_.post(pin, (portState.state & (1UL << pin)) ? Edge::RISING : Edge::FALLING);
+        }
+    }
+}
+
+/**
+ * @brief Timer callback (TIM7 interrupt context)
+ *
+ * @param context The Debouncer that armed the timer
+ */
+void Debouncer::onTimer(void* context)
+{
+    static_cast<Debouncer*>(context)->sample();
+}
+
+/**
+ * @brief Map a port to its slot (ports are 0x400 apart starting at GPIOA)
+ *
+ * @param port GPIO port
+ * @return Slot index, PORT_COUNT or more for an invalid port
+ */
+uint32_t Debouncer::getPortIndex(GPIO_TypeDef* port)
+{
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(port) - GPIOA_BASE) >> 10;
+}
+
+/**
+ * @brief Map a slot back to its port
+ *
+ * @param index Slot index
+ * @return GPIO port
+ */
+GPIO_TypeDef* Debouncer::getPort(uint32_t index)
+{
+    return reinterpret_cast<GPIO_TypeDef*>(GPIOA_BASE + (index << 10));
+}
+
+} // namespace GPIO
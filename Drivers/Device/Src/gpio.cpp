@@ -15,6 +15,9 @@
  */
 
 #include "gpio.h"
+#include "gpio_event.h"
+#include "gpio_timing.h"
+#include "SystemTime.h"
 #include "stm32l4xx_ll_exti.h"
 #include "stm32l4xx_ll_system.h"
 
@@ -27,6 +30,9 @@ namespace GPIO
 // Static registry of GPIOEXTI instances indexed by pin number
 static GPIOEXTI* extiRegistry[16] = {nullptr};
 
+// EXTI lines with an instance in the registry (bit n = extiRegistry[n] is set)
+static volatile uint32_t registeredLines = 0;
+
 //=============================================================================
 // GPIOBase Implementation
 //=============================================================================
@@ -369,12 +375,13 @@ bool GPIOInput::isLow() const {
 GPIOEXTI::GPIOEXTI(GPIO_TypeDef* port, uint32_t pin, 
                    EXTITrigger trigger, PinPull pull)
     : GPIOInput(port, pin, pull), trigger_(trigger), 
-      callback_(nullptr), interruptEnabled_(false) 
+      callback_(nullptr), eventQueue_(nullptr), edgeTimer_(nullptr), interruptEnabled_(false) 
 {
     config_.trigger = trigger;
     // Register this instance in the static registry
     if (pin < 16) {
         extiRegistry[pin] = this;
+        registeredLines |= (1UL << pin);
     }
     configureEXTI();
 }
@@ -389,11 +396,12 @@ GPIOEXTI::GPIOEXTI(GPIO_TypeDef* port, uint32_t pin,
  */
 GPIOEXTI::GPIOEXTI(const PinConfig& config) 
     : GPIOInput(config), trigger_(config.trigger), 
-      callback_(nullptr), interruptEnabled_(false) 
+      callback_(nullptr), eventQueue_(nullptr), edgeTimer_(nullptr), interruptEnabled_(false) 
 {
     // Register this instance in the static registry
     if (pin_ < 16) {
         extiRegistry[pin_] = this;
+        registeredLines |= (1UL << pin_);
     }
     configureEXTI();
 }
@@ -408,6 +416,7 @@ GPIOEXTI::~GPIOEXTI()
 {
     if (pin_ < 16 && extiRegistry[pin_] == this) {
         disableInterrupt();
+        registeredLines &= ~(1UL << pin_);
         extiRegistry[pin_] = nullptr;
     }
 }
@@ -533,31 +542,142 @@ void GPIOEXTI::disableInterrupt() {
  * @param callback Function to call on interrupt (nullptr to clear)
  * @warning Callback executes in interrupt context - keep it fast!
  */
-void GPIOEXTI::setCallback(std::function<void()> callback) {
+void GPIOEXTI::setCallback(InterruptCallback callback) {
+    // Mask the line so the ISR never sees a half-written function/context pair
+    const uint32_t extiLine = getEXTILine(pin_);
+    const bool lineEnabled = LL_EXTI_IsEnabledIT_0_31(extiLine);
+    if (lineEnabled) {
+        LL_EXTI_DisableIT_0_31(extiLine);
+    }
     callback_ = callback;
+    if (lineEnabled) {
+        LL_EXTI_EnableIT_0_31(extiLine);
+    }
+}
+
+/**
+ * @brief Set interrupt callback function with context
+ * 
+ * @param function Function to call on interrupt
+ * @param context Pointer passed to the function on every call
+ */
+void GPIOEXTI::setCallback(InterruptCallback::Function function, void* context) {
+    setCallback(InterruptCallback(function, context));
+}
+
+/**
+ * @brief Attach an event queue to this pin
+ * 
+ * @param queue Queue to post an event to on every interrupt (nullptr to detach)
+ */
+void GPIOEXTI::setEventQueue(PinEventQueue* queue) {
+    // Same masking as setCallback(): the ISR never sees a half-updated pin
+    const uint32_t extiLine = getEXTILine(pin_);
+    const bool lineEnabled = LL_EXTI_IsEnabledIT_0_31(extiLine);
+    if (lineEnabled) {
+        LL_EXTI_DisableIT_0_31(extiLine);
+    }
+    eventQueue_ = queue;
+    if (lineEnabled) {
+        LL_EXTI_EnableIT_0_31(extiLine);
+    }
+}
+
+/**
+ * @brief Attach an edge history to this pin
+ * 
+ * @param timer Edge history to record every interrupt into (nullptr to detach)
+ */
+void GPIOEXTI::setEdgeTimer(EdgeTimer* timer) {
+    const uint32_t extiLine = getEXTILine(pin_);
+    const bool lineEnabled = LL_EXTI_IsEnabledIT_0_31(extiLine);
+    if (lineEnabled) {
+        LL_EXTI_DisableIT_0_31(extiLine);
+    }
+    edgeTimer_ = timer;
+    if (lineEnabled) {
+        LL_EXTI_EnableIT_0_31(extiLine);
+    }
 }
 
 /**
- * @brief Static interrupt handler for all EXTI pins
+ * @brief Serve one interrupt of this pin
+ * 
+ * The edge of a single-edge trigger is known; for RISING_FALLING the pin level
+ * right after the edge tells the direction.
  * 
- * Central interrupt handler that dispatches to individual pin callbacks.
- * This method should be called from your EXTI interrupt service routines.
+ * @param timestamp Cycle time (TIME::nowCycles32()) taken at ISR entry
+ */
+void GPIOEXTI::onInterrupt(uint32_t timestamp) {
+    if (eventQueue_ || edgeTimer_) {
+        Edge edge;
+        if (trigger_ == EXTITrigger::RISING) {
+            edge = Edge::RISING;
+        } else if (trigger_ == EXTITrigger::FALLING) {
+            edge = Edge::FALLING;
+        } else {
+            edge = LL_GPIO_IsInputPinSet(port_, getLLPin(pin_)) ? Edge::RISING : Edge::FALLING;
+        }
+        if (edgeTimer_) {
+            edgeTimer_->record(timestamp, edge);
+        }
+        if (eventQueue_) {
+            eventQueue_->post(pin_, edge, timestamp);
+        }
+    }
+    if (callback_) {
+        callback_();
+    }
+}
+
+/**
+ * @brief Serve the GPIOEXTI registered for one EXTI line
+ * 
+ * The pending flag has already been checked and cleared by the calling ISR.
  * 
  * @param pin Pin number (0-15) that triggered the interrupt
- * @note Call this from your EXTIx_IRQHandler functions
  */
 void GPIOEXTI::handleInterrupt(uint32_t pin) {
+    const uint32_t timestamp = TIME::nowCycles32();
     if (pin >= 16) return; // Invalid pin number
     
-    uint32_t extiLine = (1U << pin);
-    if (LL_EXTI_IsActiveFlag_0_31(extiLine)) {
-        LL_EXTI_ClearFlag_0_31(extiLine);
+    GPIOEXTI* instance = extiRegistry[pin];
+    if (instance) {
+        instance->onInterrupt(timestamp);
+    }
+}
+
+/**
+ * @brief Serve all pending EXTI lines of one interrupt vector
+ * 
+ * One read of the pending register per pass, one write to clear it, then the
+ * registered lines are walked from the lowest set bit. Unregistered lines are
+ * cleared as well so they cannot retrigger the vector forever.
+ * 
+ * @param lines EXTI line mask served by the calling vector
+ */
+void GPIOEXTI::dispatch(uint32_t lines) {
+    uint32_t timestamp = TIME::nowCycles32(); // First thing: edge time for all lines of this pass
+    lines &= 0xFFFFU; // GPIO lines only
+    
+    uint32_t pending = LL_EXTI_ReadFlag_0_31(lines);
+    while (pending != 0) {
+        LL_EXTI_ClearFlag_0_31(pending);
         
-        // Find the registered GPIOEXTI instance for this pin and call its callback
-        GPIOEXTI* instance = extiRegistry[pin];
-        if (instance && instance->callback_) {
-            instance->callback_();
+        uint32_t active = __RBIT(pending & registeredLines);
+        while (active != 0) {
+            const uint32_t pin = __CLZ(active);
+            active &= ~(0x80000000UL >> pin);
+            
+            GPIOEXTI* instance = extiRegistry[pin];
+            if (instance) {
+                instance->onInterrupt(timestamp);
+            }
         }
+        
+        // Edges that arrived while the callbacks ran
+        timestamp = TIME::nowCycles32();
+        pending = LL_EXTI_ReadFlag_0_31(lines);
     }
 }
 
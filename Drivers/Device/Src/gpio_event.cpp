@@ -0,0 +1,94 @@
+/**
+ * @file gpio_event.cpp
+ * @brief Implementation of the deferred GPIO event queue
+ *
+ * @see gpio_event.h for the queue protocol
+ */
+
+#include "gpio_event.h"
+
+namespace GPIO
+{
+
+/**
+ * @brief Remove up to maxCount events in posting order
+ *
+ * Stops at the first slot whose producer has claimed but not yet filled it;
+ * that event and everything behind it are returned by a later call.
+ *
+ * @param events Destination array
+ * @param maxCount Capacity of events
+ * @return Number of events copied
+ */
+uint32_t PinEventQueue::drain(PinEvent* events, uint32_t maxCount)
+{
+    uint32_t position = tail_;
+    uint32_t count = 0;
+
+    while (count < maxCount && position != head_) {
+        const Slot& slot = slots_[position & MASK];
+        if (slot.sequence != position + 1U) {
+            break;
+        }
+        __DMB();    // Event read after its sequence number
+        events[count++] = slot.event;
+        position++;
+    }
+
+    __DMB();        // Slots copied before producers may reuse them
+    tail_ = position;
+    return count;
+}
+
+/**
+ * @brief Hand all queued events to a handler in batches
+ *
+ * @param handler Called once per batch of up to GPIO_EVENT_BATCH_SIZE events
+ * @param context Pointer passed through to the handler
+ * @return Number of events processed
+ */
+uint32_t PinEventQueue::process(BatchHandler handler, void* context)
+{
+    PinEvent batch[GPIO_EVENT_BATCH_SIZE];
+    uint32_t total = 0;
+    uint32_t count;
+
+    while ((count = drain(batch, GPIO_EVENT_BATCH_SIZE)) != 0) {
+        handler(batch, count, context);
+        total += count;
+    }
+    return total;
+}
+
+/**
+ * @brief Read and clear the mask of pins that lost events
+ *
+ * @return Pin mask (bit n = pin n) accumulated since the previous call
+ */
+uint32_t PinEventQueue::takeOverflowPins()
+{
+    uint32_t pins;
+    do {
+        pins = __LDREXW(&overflowPins_);
+    } while (__STREXW(0U, &overflowPins_) != 0);
+    return pins;
+}
+
+/**
+ * @brief Count a dropped event and remember its pin (interrupt context)
+ *
+ * @param pin Pin whose event did not fit
+ */
+void PinEventQueue::recordOverflow(uint32_t pin)
+{
+    uint32_t value;
+    do {
+        value = __LDREXW(&dropped_);
+    } while (__STREXW(value + 1U, &dropped_) != 0);
+
+    do {
+        value = __LDREXW(&overflowPins_);
+    } while (__STREXW(value | (1UL << pin), &overflowPins_) != 0);
+}
+
+} // namespace GPIO
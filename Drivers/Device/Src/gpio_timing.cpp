@@ -0,0 +1,126 @@
+/**
+ * @file gpio_timing.cpp
+ * @brief Implementation of the EdgeTimer timing queries
+ *
+ * @see gpio_timing.h
+ */
+
+#include "gpio_timing.h"
+
+namespace GPIO
+{
+
+// Snapshot attempts before giving up on a signal that outruns the reader
+static constexpr uint32_t SNAPSHOT_RETRIES = 4;
+
+/**
+ * @brief Copy the most recent edges, oldest first
+ *
+ * The ISR only overwrites the slot of the oldest edge, so the copy is valid if
+ * fewer than (history size - copied edges) new edges arrived meanwhile.
+ *
+ * @param samples Destination array
+ * @param maxCount Capacity of samples
+ * @return Number of edges copied
+ */
+uint32_t EdgeTimer::getHistory(EdgeSample* samples, uint32_t maxCount) const
+{
+    for (uint32_t attempt = 0; attempt < SNAPSHOT_RETRIES; attempt++) {
+        const uint32_t end = count_;
+        __DMB();    // Count read before the samples
+
+        uint32_t available = (end < GPIO_EDGE_HISTORY_SIZE) ? end : GPIO_EDGE_HISTORY_SIZE;
+        if (available > maxCount) {
+            available = maxCount;
+        }
+        const uint32_t begin = end - available;
+        for (uint32_t i = 0; i < available; i++) {
+            samples[i] = samples_[(begin + i) & MASK];
+        }
+
+        __DMB();    // Samples read before the count is checked again
+        if (count_ - end <= GPIO_EDGE_HISTORY_SIZE - available) {
+            return available;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Duration of the last complete pulse at a level
+ *
+ * Searches backwards for the newest edge leaving the level, preceded
+ * directly by the edge entering it.
+ *
+ * @param level Pulse level (HIGH or LOW)
+ * @param cycles Pulse width in core clock cycles
+ * @return false if no complete pulse is in the history
+ */
+bool EdgeTimer::getPulseWidth(PinState level, uint32_t& cycles) const
+{
+    EdgeSample history[GPIO_EDGE_HISTORY_SIZE];
+    const uint32_t count = getHistory(history, GPIO_EDGE_HISTORY_SIZE);
+
+    const Edge enter = (level == PinState::HIGH) ? Edge::RISING : Edge::FALLING;
+    const Edge leave = (level == PinState::HIGH) ? Edge::FALLING : Edge::RISING;
+
+    for (uint32_t i = count; i >= 2; i--) {
+        if (history[i - 1].edge == leave && history[i - 2].edge == enter) {
+            cycles = history[i - 1].timestamp - history[i - 2].timestamp;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Average period over the most recent edges
+ *
+ * Only edges with the direction of the newest edge are used, so a missed edge
+ * of the other direction does not halve the result.
+ *
+ * @param cycles Average period in core clock cycles
+ * @param edges Number of most recent edges to consider
+ * @return false if fewer than two edges of one direction are available
+ */
+bool EdgeTimer::getPeriod(uint32_t& cycles, uint32_t edges) const
+{
+    EdgeSample history[GPIO_EDGE_HISTORY_SIZE];
+    const uint32_t count = getHistory(history, (edges < GPIO_EDGE_HISTORY_SIZE) ? edges : GPIO_EDGE_HISTORY_SIZE);
+    if (count < 2) {
+        return false;
+    }
+
+    const EdgeSample& newest = history[count - 1];
+    uint32_t oldest = newest.timestamp;
+    uint32_t intervals = 0;
+    for (uint32_t i = count - 1; i-- > 0;) {
+        if (history[i].edge == newest.edge) {
+            oldest = history[i].timestamp;
+            intervals++;
+        }
+    }
+    if (intervals == 0) {
+        return false;
+    }
+
+    cycles = (newest.timestamp - oldest) / intervals;
+    return true;
+}
+
+/**
+ * @brief Signal frequency derived from the average period
+ *
+ * @param edges Number of most recent edges to consider
+ * @return Frequency in Hz, 0 if no period is available
+ */
+float EdgeTimer::getFrequency(uint32_t edges) const
+{
+    uint32_t period;
+    if (!getPeriod(period, edges) || period == 0) {
+        return 0.0f;
+    }
+    return static_cast<float>(SystemCoreClock) / static_cast<float>(period);
+}
+
+} // namespace GPIO
@@ -0,0 +1,531 @@
+/**
+ * @file timer_wheel.cpp
+ * @brief Implementation of the TIM7 hierarchical timer wheel
+ *
+ * @see timer_wheel.h for the wheel layout
+ */
+
+#include "timer_wheel.h"
+#include "SystemTime.h"
+#include "CriticalSection.h"
+
+namespace TIMER
+{
+//=============================================================================
+// TIM7 Binding
+//=============================================================================
+
+// Wheel served by TIM7_IRQHandler
+static TimerWheel* activeWheel = nullptr;
+
+// Preemption priority of the timer interrupt (below the EXTI lines at 10)
+static constexpr uint32_t TIMER_IRQ_PRIORITY = 11;
+
+// TIM7 counts at 10 kHz; one-pulse waits are 1..65536 counts (6.5 s)
+static constexpr uint32_t COUNT_US = 100;
+static constexpr uint32_t MAX_COUNTS = 65536;
+static constexpr uint32_t MAX_WAIT_TICKS = (MAX_COUNTS * COUNT_US) / TIMER_WHEEL_TICK_US;
+
+static_assert(TIMER_WHEEL_TICK_US % COUNT_US == 0, "TIMER_WHEEL_TICK_US must be a multiple of 100 us");
+
+/**
+ * @brief Index of the lowest set bit of a non-zero 64-bit mask
+ */
+static inline uint32_t lowestBit(uint64_t mask)
+{
+    const uint32_t low = static_cast<uint32_t>(mask);
+    if (low != 0) {
+        return __CLZ(__RBIT(low));
+    }
+    return 32U + __CLZ(__RBIT(static_cast<uint32_t>(mask >> 32)));
+}
+
+/**
+ * @brief Rotate a 64-bit mask right
+ */
+static inline uint64_t rotateRight(uint64_t mask, uint32_t count)
+{
+    return (count == 0) ? mask : ((mask >> count) | (mask << (64U - count)));
+}
+
+//=============================================================================
+// TimerWheel Implementation
+//=============================================================================
+
+/**
+ * @brief Configure TIM7 as a one-pulse 10 kHz wake-up timer
+ *
+ * TIM7 runs from the APB1 timer clock, which is twice PCLK1 when the APB1
+ * prescaler is not 1. Only counter overflows raise the update flag, so loading
+ * the prescaler with a software update does not fire the interrupt.
+ */
+void TimerWheel::begin()
+{
+    LL_RCC_ClocksTypeDef clocks;
+    LL_RCC_GetSystemClocksFreq(&clocks);
+    uint32_t timerClock = clocks.PCLK1_Frequency;
+    if (LL_RCC_GetAPB1Prescaler() != LL_RCC_APB1_DIV_1) {
+        timerClock *= 2U;
+    }
+
+    LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_TIM7);
+    LL_TIM_DisableCounter(TIM7);
+    LL_TIM_SetUpdateSource(TIM7, LL_TIM_UPDATESOURCE_COUNTER);
+    LL_TIM_SetOnePulseMode(TIM7, LL_TIM_ONEPULSEMODE_SINGLE);
+    LL_TIM_SetPrescaler(TIM7, (timerClock / (1000000U / COUNT_US)) - 1U);
+    LL_TIM_GenerateEvent_UPDATE(TIM7);   // Load the prescaler now
+    LL_TIM_ClearFlag_UPDATE(TIM7);
+    LL_TIM_EnableIT_UPDATE(TIM7);
+
+    CriticalSection lock;
+    current_ = now();
+    activeWheel = this;
+    NVIC_SetPriority(TIM7_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), TIMER_IRQ_PRIORITY, 0));
+    NVIC_EnableIRQ(TIM7_IRQn);
+    schedule();
+}
+
+/**
+ * @brief Arm a one-shot timer
+ *
+ * @param timer Timer to arm
+ * @param delayTicks Ticks until expiry (0 = next tick)
+ */
+void TimerWheel::startOneShot(Timer& timer, uint32_t delayTicks)
+{
+    arm(timer, delayTicks, 0);
+}
+
+/**
+ * @brief Arm a periodic timer
+ *
+ * @param timer Timer to arm
+ * @param periodTicks Ticks between expiries (0 is treated as 1)
+ * @param firstDelayTicks Ticks until the first expiry
+ */
+void TimerWheel::startPeriodic(Timer& timer, uint32_t periodTicks, uint32_t firstDelayTicks)
+{
+    arm(timer, firstDelayTicks, (periodTicks != 0) ? periodTicks : 1U);
+}
+
+/**
+ * @brief Disarm a timer
+ *
+ * @param timer Timer to stop
+ */
+void TimerWheel::stop(Timer& timer)
+{
+    CriticalSection lock;
+    if (timer.list_ != Timer::NO_LIST) {
+        unlink(timer);
+    }
+    if (timer.deferred_) {
+        removeDeferred(timer);
+    }
+    schedule();
+}
+
+/**
+ * @brief Run queued thread-mode callbacks in expiry order
+ *
+ * A callback may start or stop any timer, including its own.
+ *
+ * @return Number of callbacks run
+ */
+uint32_t TimerWheel::runDeferred()
+{
+    uint32_t count = 0;
+
+    while (true) {
+        Timer::Callback callback;
+        void* context;
+        {
+            CriticalSection lock;
+            Timer* timer = deferredHead_;
+            if (timer == nullptr) {
+                break;
+            }
+            deferredHead_ = timer->deferredNext_;
+            if (deferredHead_ == nullptr) {
+                deferredTail_ = nullptr;
+            }
+            timer->deferredNext_ = nullptr;
+            timer->deferred_ = false;
+            callback = timer->callback_;
+            context = timer->context_;
+        }
+        callback(context);
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Current wheel time in ticks
+ */
+uint32_t TimerWheel::now()
+{
+    return static_cast<uint32_t>(TIME::nowUs() / TIMER_WHEEL_TICK_US);
+}
+
+/**
+ * @brief TIM7 update interrupt handler
+ */
+void TimerWheel::handleInterrupt()
+{
+    if (activeWheel) {
+        activeWheel->serve();
+    } else {
+        LL_TIM_ClearFlag_UPDATE(TIM7);
+    }
+}
+
+/**
+ * @brief (Re)arm a timer relative to the current time
+ *
+ * @param timer Timer to arm
+ * @param delayTicks Ticks until the first expiry
+ * @param periodTicks Ticks between expiries, 0 = one-shot
+ */
+void TimerWheel::arm(Timer& timer, uint32_t delayTicks, uint32_t periodTicks)
+{
+    if (delayTicks == 0) {
+        delayTicks = 1;
+    } else if (delayTicks > MAX_DELAY) {
+        delayTicks = MAX_DELAY;
+    }
+
+    CriticalSection lock;
+    if (timer.list_ != Timer::NO_LIST) {
+        unlink(timer);
+    }
+    catchUp();
+    timer.expires_ = now() + delayTicks;
+    timer.period_ = (periodTicks > MAX_DELAY) ? MAX_DELAY : periodTicks;
+    insert(timer);
+    schedule();
+}
+
+/**
+ * @brief Put a timer into the slot for its expiry
+ *
+ * The level is chosen by the distance from current_: level k holds timers due
+ * 64^k to 64^(k+1) - 1 ticks ahead, in the slot indexed by bits 6k..6k+5 of the
+ * expiry tick. That slot is next processed at the last multiple of 64^k at or
+ * before the expiry, where the timer either fires or cascades to a lower level.
+ * Expiries beyond the top level are parked at its far end and re-queued when
+ * reached.
+ *
+ * @param timer Timer with expires_ after current_
+ */
+void TimerWheel::insert(Timer& timer)
+{
+    uint32_t delta = timer.expires_ - current_;
+    uint32_t expires = timer.expires_;
+
+    if (delta > MAX_DELTA) {
+        delta = MAX_DELTA;
+        expires = current_ + MAX_DELTA;
+    }
+
+    uint32_t level = 0;
+    while (level < LEVELS - 1U && delta >= (1UL << ((level + 1U) * SLOT_BITS))) {
+        level++;
+    }
+
+    const uint32_t slot = (expires >> (level * SLOT_BITS)) & SLOT_MASK;
+    push(timer, static_cast<uint16_t>(level * SLOTS + slot));
+}
+
+/**
+ * @brief Link a timer at the head of a list and mark the slot occupied
+ *
+ * @param timer Timer that is on no list
+ * @param list List index (slot or EXPIRED_LIST)
+ */
+void TimerWheel::push(Timer& timer, uint16_t list)
+{
+    Timer* head = lists_[list];
+    timer.prev_ = nullptr;
+    timer.next_ = head;
+    if (head) {
+        head->prev_ = &timer;
+    }
+    lists_[list] = &timer;
+    timer.list_ = list;
+
+    if (list != EXPIRED_LIST) {
+        occupied_[list / SLOTS] |= 1ULL << (list % SLOTS);
+    }
+}
+
+/**
+ * @brief Unlink a timer from its list in O(1)
+ *
+ * @param timer Timer on a list
+ */
+void TimerWheel::unlink(Timer& timer)
+{
+    const uint16_t list = timer.list_;
+
+    if (timer.prev_) {
+        timer.prev_->next_ = timer.next_;
+    } else {
+        lists_[list] = timer.next_;
+    }
+    if (timer.next_) {
+        timer.next_->prev_ = timer.prev_;
+    }
+    timer.next_ = nullptr;
+    timer.prev_ = nullptr;
+    timer.list_ = Timer::NO_LIST;
+
+    if (list != EXPIRED_LIST && lists_[list] == nullptr) {
+        occupied_[list / SLOTS] &= ~(1ULL << (list % SLOTS));
+    }
+}
+
+/**
+ * @brief Drop a queued thread-mode run
+ *
+ * The deferred queue only holds timers that already expired, so it is short.
+ *
+ * @param timer Timer on the deferred queue
+ */
+void TimerWheel::removeDeferred(Timer& timer)
+{
+    Timer* previous = nullptr;
+    for (Timer* entry = deferredHead_; entry; previous = entry, entry = entry->deferredNext_) {
+        if (entry != &timer) {
+            continue;
+        }
+        if (previous) {
+            previous->deferredNext_ = entry->deferredNext_;
+        } else {
+            deferredHead_ = entry->deferredNext_;
+        }
+        if (deferredTail_ == entry) {
+            deferredTail_ = previous;
+        }
+        break;
+    }
+    timer.deferredNext_ = nullptr;
+    timer.deferred_ = false;
+}
+
+/**
+ * @brief Find the next tick at which an occupied slot must be processed
+ *
+ * Slot s of level k is processed at the first tick after current_ that is a
+ * multiple of 64^k with bits 6k..6k+5 equal to s. Rotating the occupancy mask
+ * so that the slot after the current one is bit 0 turns the search into one
+ * count-trailing-zeros per level.
+ *
+ * @param delta Ticks from current_ to that tick
+ * @return false if no timer is armed
+ */
+bool TimerWheel::nextEvent(uint32_t& delta) const
+{
+    bool found = false;
+
+    for (uint32_t level = 0; level < LEVELS; level++) {
+        if (occupied_[level] == 0) {
+            continue;
+        }
+        const uint32_t shift = level * SLOT_BITS;
+        const uint32_t position = current_ >> shift;
+        const uint64_t ahead = rotateRight(occupied_[level], (position + 1U) & SLOT_MASK);
+        const uint32_t tick = (position + lowestBit(ahead) + 1U) << shift;
+        const uint32_t distance = tick - current_;
+        if (!found || distance < delta) {
+            delta = distance;
+            found = true;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Move current_ up to the present when nothing is due in between
+ *
+ * Keeps expiries of newly armed timers within range of current_ after the
+ * wheel has been idle. When a slot is due, TIM7 is about to process it and
+ * current_ is left alone.
+ */
+void TimerWheel::catchUp()
+{
+    const uint32_t target = now();
+    const uint32_t elapsed = target - current_;
+    uint32_t delta;
+
+    if (static_cast<int32_t>(elapsed) > 0 && (!nextEvent(delta) || delta > elapsed)) {
+        current_ = target;
+    }
+}
+
+/**
+ * @brief Process the slots of one tick
+ *
+ * Timers due at the tick move to the expired list; timers of cascading
+ * higher-level slots are re-inserted closer to their expiry.
+ *
+ * @param tick Tick to process, the next one returned by nextEvent()
+ */
+void TimerWheel::collect(uint32_t tick)
+{
+    current_ = tick;
+
+    for (uint32_t level = 0; level < LEVELS; level++) {
+        const uint32_t shift = level * SLOT_BITS;
+        if (level != 0 && (tick & ((1UL << shift) - 1U)) != 0) {
+            break;  // Higher levels only turn on multiples of 64^level
+        }
+
+        const uint32_t list = level * SLOTS + ((tick >> shift) & SLOT_MASK);
+        Timer* timer = lists_[list];
+        lists_[list] = nullptr;
+        occupied_[level] &= ~(1ULL << (list % SLOTS));
+
+        while (timer) {
+            Timer* next = timer->next_;
+            if (timer->expires_ == tick) {
+                push(*timer, EXPIRED_LIST);
+            } else {
+                insert(*timer);
+            }
+            timer = next;
+        }
+    }
+}
+
+/**
+ * @brief Re-arm and run the timers on the expired list
+ *
+ * Periodic timers are re-armed from their previous expiry before the callback
+ * runs, so the callback may stop them. Periods that already passed are skipped
+ * and counted as overruns. Interrupts are enabled while a callback runs.
+ */
+void TimerWheel::runExpired()
+{
+    while (true) {
+        Timer::Callback callback;
+        void* context;
+        {
+            CriticalSection lock;
+            Timer* timer = lists_[EXPIRED_LIST];
+            if (timer == nullptr) {
+                return;
+            }
+            unlink(*timer);
+
+            if (timer->period_ != 0) {
+                uint32_t expires = timer->expires_ + timer->period_;
+                const uint32_t late = current_ - expires;
+                if (static_cast<int32_t>(late) >= 0) {
+                    const uint32_t missed = late / timer->period_ + 1U;
+                    expires += missed * timer->period_;
+                    timer->overruns_ += missed;
+                }
+                timer->expires_ = expires;
+                insert(*timer);
+            }
+
+            if (timer->where_ == Context::THREAD) {
+                if (timer->deferred_) {
+                    timer->overruns_++;     // Previous run still queued: coalesce
+                } else {
+                    timer->deferred_ = true;
+                    if (deferredTail_) {
+                        deferredTail_->deferredNext_ = timer;
+                    } else {
+                        deferredHead_ = timer;
+                    }
+                    deferredTail_ = timer;
+                }
+                continue;
+            }
+            callback = timer->callback_;
+            context = timer->context_;
+        }
+        callback(context);
+    }
+}
+
+/**
+ * @brief Process every due tick up to a target, skipping empty ones
+ *
+ * @param target Tick to advance to, normally now()
+ */
+void TimerWheel::advance(uint32_t target)
+{
+    while (true) {
+        {
+            CriticalSection lock;
+            const uint32_t elapsed = target - current_;
+            uint32_t delta;
+            if (static_cast<int32_t>(elapsed) <= 0) {
+                return;
+            }
+            if (!nextEvent(delta) || delta > elapsed) {
+                current_ = target;
+                return;
+            }
+            collect(current_ + delta);
+        }
+        runExpired();
+    }
+}
+
+/**
+ * @brief Program TIM7 for the next due slot, or stop it when idle
+ *
+ * Waits longer than TIM7 can count end early; the interrupt then finds
+ * nothing due and programs the remainder. Call with interrupts masked.
+ */
+void TimerWheel::schedule()
+{
+    if (activeWheel != this) {
+        return;
+    }
+
+    LL_TIM_DisableCounter(TIM7);
+    LL_TIM_ClearFlag_UPDATE(TIM7);
+
+    uint32_t delta;
+    if (!nextEvent(delta)) {
+        return;     // No timers: TIM7 stays off
+    }
+
+    const uint64_t nowUs = TIME::nowUs();
+    const uint32_t nowTick = static_cast<uint32_t>(nowUs / TIMER_WHEEL_TICK_US);
+    const int32_t ticks = static_cast<int32_t>(current_ + delta - nowTick);
+    if (ticks <= 0) {
+        NVIC_SetPendingIRQ(TIM7_IRQn);  // Already due
+        return;
+    }
+
+    uint32_t counts = MAX_COUNTS;
+    if (static_cast<uint32_t>(ticks) < MAX_WAIT_TICKS) {
+        const uint32_t waitUs = static_cast<uint32_t>(ticks) * TIMER_WHEEL_TICK_US
+                              - static_cast<uint32_t>(nowUs % TIMER_WHEEL_TICK_US);
+        counts = (waitUs + COUNT_US - 1U) / COUNT_US;
+    }
+
+    LL_TIM_SetAutoReload(TIM7, (counts > 1U) ? counts - 1U : 1U);
+    LL_TIM_SetCounter(TIM7, 0);
+    LL_TIM_EnableCounter(TIM7);
+}
+
+/**
+ * @brief Interrupt work: catch up with the time base and re-program TIM7
+ */
+void TimerWheel::serve()
+{
+    LL_TIM_ClearFlag_UPDATE(TIM7);
+    advance(now());
+
+    CriticalSection lock;
+    schedule();
+}
+
+} // namespace TIMER
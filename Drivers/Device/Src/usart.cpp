@@ -9,12 +9,110 @@
  */
 
 #include "usart.h"
+#include "StreamFormatter.h"
+#include "CriticalSection.h"
 #include "stm32l4xx_ll_lpuart.h"
+#include "stm32l4xx_ll_dma.h"
+
+#include <new>
 
 namespace USART
 {
-    // Global instance pointer for interrupt handling (simplified approach)
-    static void* g_lpuart1Instance = nullptr;
+    /**
+     * @brief Type-erased interrupt entry points of one driver instance
+     */
+    struct InterruptBinding {
+        void* instance;
+        void (*peripheral)(void* instance);
+        void (*dmaTx)(void* instance);
+        void (*dmaRx)(void* instance);
+    };
+
+    // Interrupt dispatch table indexed by PeripheralType
+    static InterruptBinding g_interruptBindings[PERIPHERAL_COUNT] = {};
+
+    /**
+     * @brief Static trampolines restoring the concrete driver type for the dispatch table
+     */
+    template<uint16_t BUFFER_SIZE>
+    struct InterruptThunks {
+        static void peripheral(void* instance) {
+            static_cast<UsartDriver<BUFFER_SIZE>*>(instance)->handleInterrupt();
+        }
+        static void dmaTx(void* instance) {
+            static_cast<UsartDriver<BUFFER_SIZE>*>(instance)->handleDmaTxInterrupt();
+        }
+        static void dmaRx(void* instance) {
+            static_cast<UsartDriver<BUFFER_SIZE>*>(instance)->handleDmaRxInterrupt();
+        }
+    };
+
+    static uint32_t toIndex(PeripheralType peripheral) {
+        return static_cast<uint32_t>(peripheral);
+    }
+
+    /**
+     * @brief DMA channel and request line serving one USART direction
+     */
+    struct DmaRoute {
+        DMA_TypeDef* dma;
+        uint32_t channel;   // LL_DMA_CHANNEL_x
+        uint32_t request;   // LL_DMA_REQUEST_x (CSELR mapping)
+        IRQn_Type irqn;
+    };
+
+    /**
+     * @brief Get the TX DMA route for a peripheral (RM0394 DMA request mapping)
+     */
+    static DmaRoute getTxDmaRoute(PeripheralType peripheral) {
+        switch (peripheral) {
+            case PeripheralType::USART_1:
+                return { DMA1, LL_DMA_CHANNEL_4, LL_DMA_REQUEST_2, DMA1_Channel4_IRQn };
+            case PeripheralType::USART_2:
+                return { DMA1, LL_DMA_CHANNEL_7, LL_DMA_REQUEST_2, DMA1_Channel7_IRQn };
+            case PeripheralType::USART_3:
+                return { DMA1, LL_DMA_CHANNEL_2, LL_DMA_REQUEST_2, DMA1_Channel2_IRQn };
+            case PeripheralType::LPUART_1:
+            default:
+                return { DMA2, LL_DMA_CHANNEL_6, LL_DMA_REQUEST_4, DMA2_Channel6_IRQn };
+        }
+    }
+
+    /**
+     * @brief Get the RX DMA route for a peripheral (RM0394 DMA request mapping)
+     */
+    static DmaRoute getRxDmaRoute(PeripheralType peripheral) {
+        switch (peripheral) {
+            case PeripheralType::USART_1:
+                return { DMA1, LL_DMA_CHANNEL_5, LL_DMA_REQUEST_2, DMA1_Channel5_IRQn };
+            case PeripheralType::USART_2:
+                return { DMA1, LL_DMA_CHANNEL_6, LL_DMA_REQUEST_2, DMA1_Channel6_IRQn };
+            case PeripheralType::USART_3:
+                return { DMA1, LL_DMA_CHANNEL_3, LL_DMA_REQUEST_2, DMA1_Channel3_IRQn };
+            case PeripheralType::LPUART_1:
+            default:
+                return { DMA2, LL_DMA_CHANNEL_7, LL_DMA_REQUEST_4, DMA2_Channel7_IRQn };
+        }
+    }
+
+    /**
+     * @brief Enable the clock of the DMA controller serving a route
+     */
+    static void enableDmaClock(const DmaRoute& route) {
+        if (route.dma == DMA1) {
+            LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+        } else {
+            LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA2);
+        }
+    }
+
+    /**
+     * @brief Clear all interrupt flags of a DMA channel
+     */
+    static void clearDmaChannelFlags(const DmaRoute& route) {
+        // Flags are laid out in groups of 4 bits per channel (GIF, TCIF, HTIF, TEIF)
+        WRITE_REG(route.dma->IFCR, (DMA_IFCR_CGIF1 << (route.channel * 4U)));
+    }
 
     /**
      * @brief Get default configuration for LPUART1
@@ -27,27 +125,65 @@ namespace USART
         cfg.parity = 0x00000000U;      // LL_LPUART_PARITY_NONE
         cfg.hwFlowControl = 0x00000000U; // LL_LPUART_HWCONTROL_NONE
         cfg.transferDirection = 0x0000000CU; // USART_CR1_TE | USART_CR1_RE (0x08 | 0x04)
+        cfg.txMode = TransferMode::DMA;      // DMA2 channel 6, two interrupts per buffer wrap
         return cfg;
     }
 
     /**
-     * @brief Get default configuration for USART (placeholder for when USART LL is added)
+     * @brief Get default configuration for USART1/2/3
+     * @note Field values are CR1/CR2/CR3 bit patterns, shared with LPUART1
      */
     Config getDefaultUsartConfig() {
         Config cfg;
         cfg.baudRate = 115200;
-        // Note: These would be USART-specific constants when USART LL driver is available
-        cfg.wordLength = 0; // LL_USART_DATAWIDTH_8B equivalent
-        cfg.stopBits = 0;   // LL_USART_STOPBITS_1 equivalent  
-        cfg.parity = 0;     // LL_USART_PARITY_NONE equivalent
-        cfg.hwFlowControl = 0; // LL_USART_HWCONTROL_NONE equivalent
-        cfg.transferDirection = 0; // LL_USART_DIRECTION_TX_RX equivalent
+        cfg.wordLength = 0x00000000U;  // 8 data bits (M1:M0 = 00)
+        cfg.stopBits = 0x00000000U;    // 1 stop bit (CR2 STOP = 00)
+        cfg.parity = 0x00000000U;      // No parity (PCE = 0)
+        cfg.hwFlowControl = 0x00000000U; // No RTS/CTS
+        cfg.transferDirection = USART_CR1_TE | USART_CR1_RE;
+        cfg.txMode = TransferMode::DMA;
         return cfg;
     }
 
+    /**
+     * @brief Compute BRR and oversampling for a USART kernel clock
+     * @param clock Kernel clock frequency in Hz
+     * @param baudRate Requested baud rate
+     * @param brr Receives the BRR register value
+     * @param over8 Receives true if 8x oversampling is required
+     * @return false if the baud rate is above clock/8 or below clock/65535
+     */
+    static bool computeUsartBrr(uint32_t clock, uint32_t baudRate, uint32_t& brr, bool& over8) {
+        if (baudRate == 0U) {
+            return false;
+        }
+
+        // 16x oversampling tolerates more clock deviation; use it whenever USARTDIV >= 16
+        uint32_t usartDiv = (clock + (baudRate / 2U)) / baudRate;
+        if (usartDiv >= 16U) {
+            if (usartDiv > 0xFFFFU) {
+                return false;
+            }
+            over8 = false;
+            brr = usartDiv;
+            return true;
+        }
+
+        // 8x oversampling: BRR[3] must be 0 and BRR[2:0] holds USARTDIV[3:0] >> 1
+        usartDiv = ((2U * clock) + (baudRate / 2U)) / baudRate;
+        if (usartDiv < 16U) {
+            return false;
+        }
+        over8 = true;
+        brr = (usartDiv & 0xFFF0U) | ((usartDiv & 0x000FU) >> 1U);
+        return true;
+    }
+
     template<uint16_t BUFFER_SIZE>
     UsartDriver<BUFFER_SIZE>::UsartDriver(PeripheralType peripheral)
-        : peripheralType(peripheral), usartInstance(nullptr), transmissionActive(false) {
+        : peripheralType(peripheral), usartInstance(nullptr), transmissionActive(false),
+          dmaTxLength(0), rxWritten(0), rxRead(0), rxDmaPosition(0), rxOverruns(0), rxErrors(0),
+          txIdleCallback(nullptr), txIdleContext(nullptr), rxCallback(nullptr), rxContext(nullptr) {
         
         // Set the hardware instance based on peripheral type
         switch (peripheral) {
@@ -66,9 +202,33 @@ namespace USART
         }
     }
 
+    template<uint16_t BUFFER_SIZE>
+    UsartDriver<BUFFER_SIZE>::~UsartDriver() {
+        CriticalSection lock;
+        InterruptBinding& binding = g_interruptBindings[toIndex(peripheralType)];
+        if (binding.instance == this) {
+            binding = InterruptBinding{};
+        }
+    }
+
+    template<uint16_t BUFFER_SIZE>
+    void UsartDriver<BUFFER_SIZE>::bindInterrupts() {
+        // Bound before any interrupt source is enabled; last initialised instance wins
+        CriticalSection lock;
+        g_interruptBindings[toIndex(peripheralType)] = InterruptBinding{
+            this,
+            &InterruptThunks<BUFFER_SIZE>::peripheral,
+            &InterruptThunks<BUFFER_SIZE>::dmaTx,
+            &InterruptThunks<BUFFER_SIZE>::dmaRx
+        };
+    }
+
     template<uint16_t BUFFER_SIZE>
     bool UsartDriver<BUFFER_SIZE>::initialize(const Config& cfg) {
         config = cfg;
+
+        // Register this instance for interrupt handling
+        bindInterrupts();
         
         switch (peripheralType) {
             case PeripheralType::LPUART_1:
@@ -77,9 +237,19 @@ namespace USART
             case PeripheralType::USART_1:
             case PeripheralType::USART_2:
             case PeripheralType::USART_3:
-                initializeUsart();
+                if (!initializeUsart()) {
+                    return false;
+                }
                 break;
         }
+
+        if (config.txMode == TransferMode::DMA) {
+            initializeTxDma();
+        }
+
+        if ((config.transferDirection & USART_CR1_RE) != 0U) {
+            initializeRxDma();
+        }
         
         return true;
     }
@@ -102,11 +272,8 @@ namespace USART
         // Enable LPUART
         LL_LPUART_Enable(lpuart);
         
-        // Register this instance for interrupt handling
-        registerLpuart1Handler(this);
-        
-        // Enable TX empty interrupt
-        LL_LPUART_EnableIT_TXE(lpuart);
+        // TX empty interrupt is only enabled while bytes are queued
+        LL_LPUART_DisableIT_TXE(lpuart);
         
         // Enable NVIC interrupt
         NVIC_SetPriority(LPUART1_IRQn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 0, 0));
@@ -114,28 +281,185 @@ namespace USART
     }
 
     template<uint16_t BUFFER_SIZE>
-    void UsartDriver<BUFFER_SIZE>::initializeUsart() {
-        // Note: This would be implemented when USART LL drivers are available
-        // For now, this is a placeholder that shows the structure
-        [[maybe_unused]] USART_TypeDef* usart = static_cast<USART_TypeDef*>(usartInstance);
+    bool UsartDriver<BUFFER_SIZE>::initializeUsart() {
+        USART_TypeDef* usart = static_cast<USART_TypeDef*>(usartInstance);
+        uint32_t kernelClock = 0;
+        IRQn_Type irqn = USART1_IRQn;
         
         // Enable appropriate clock based on USART instance
         switch (peripheralType) {
             case PeripheralType::USART_1:
                 LL_APB2_GRP1_EnableClock(LL_APB2_GRP1_PERIPH_USART1);
+                kernelClock = LL_RCC_GetUSARTClockFreq(LL_RCC_USART1_CLKSOURCE);
+                irqn = USART1_IRQn;
                 break;
             case PeripheralType::USART_2:
                 LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_USART2);
+                kernelClock = LL_RCC_GetUSARTClockFreq(LL_RCC_USART2_CLKSOURCE);
+                irqn = USART2_IRQn;
                 break;
             case PeripheralType::USART_3:
                 LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_USART3);
+                kernelClock = LL_RCC_GetUSARTClockFreq(LL_RCC_USART3_CLKSOURCE);
+                irqn = USART3_IRQn;
                 break;
             default:
-                break;
+                return false;
         }
+
+        uint32_t brr;
+        bool over8;
+        if (!computeUsartBrr(kernelClock, config.baudRate, brr, over8)) {
+            return false;
+        }
+        
+        // Frame format and BRR may only be changed while UE = 0
+        CLEAR_BIT(usart->CR1, USART_CR1_UE);
+
+        WRITE_REG(usart->CR1, config.wordLength | config.parity | config.transferDirection |
+                              (over8 ? USART_CR1_OVER8 : 0U));
+        MODIFY_REG(usart->CR2, USART_CR2_STOP, config.stopBits);
+        MODIFY_REG(usart->CR3, USART_CR3_RTSE | USART_CR3_CTSE, config.hwFlowControl);
+        WRITE_REG(usart->BRR, brr);
+        
+        // Enable USART; TX empty interrupt is only enabled while bytes are queued
+        SET_BIT(usart->CR1, USART_CR1_UE);
         
-        // TODO: Implement USART configuration when LL drivers are available
-        // This would include baud rate, data width, stop bits, parity, etc.
+        // Enable NVIC interrupt
+        NVIC_SetPriority(irqn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 0, 0));
+        NVIC_EnableIRQ(irqn);
+        
+        return true;
+    }
+
+    template<uint16_t BUFFER_SIZE>
+    void UsartDriver<BUFFER_SIZE>::initializeTxDma() {
+        USART_TypeDef* usart = static_cast<USART_TypeDef*>(usartInstance);
+        const DmaRoute route = getTxDmaRoute(peripheralType);
+
+        enableDmaClock(route);
+
+        // Memory -> TDR, byte wide, one-shot; memory address and length are set per region
+        LL_DMA_DisableChannel(route.dma, route.channel);
+        LL_DMA_SetPeriphRequest(route.dma, route.channel, route.request);
+        LL_DMA_ConfigTransfer(route.dma, route.channel,
+                              LL_DMA_DIRECTION_MEMORY_TO_PERIPH |
+                              LL_DMA_MODE_NORMAL |
+                              LL_DMA_PERIPH_NOINCREMENT |
+                              LL_DMA_MEMORY_INCREMENT |
+                              LL_DMA_PDATAALIGN_BYTE |
+                              LL_DMA_MDATAALIGN_BYTE |
+                              LL_DMA_PRIORITY_LOW);
+        LL_DMA_SetPeriphAddress(route.dma, route.channel, reinterpret_cast<uint32_t>(&usart->TDR));
+        LL_DMA_EnableIT_TC(route.dma, route.channel);
+        LL_DMA_EnableIT_TE(route.dma, route.channel);
+
+        // Route TXE to the DMA request line instead of the CPU
+        SET_BIT(usart->CR3, USART_CR3_DMAT);
+
+        NVIC_SetPriority(route.irqn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 0, 0));
+        NVIC_EnableIRQ(route.irqn);
+    }
+
+    template<uint16_t BUFFER_SIZE>
+    void UsartDriver<BUFFER_SIZE>::initializeRxDma() {
+        USART_TypeDef* usart = static_cast<USART_TypeDef*>(usartInstance);
+        const DmaRoute route = getRxDmaRoute(peripheralType);
+
+        enableDmaClock(route);
+
+        rxWritten = 0;
+        rxRead = 0;
+        rxDmaPosition = 0;
+
+        // RDR -> rxBuffer, circular: the DMA never stops, the CPU only tracks its position
+        LL_DMA_DisableChannel(route.dma, route.channel);
+        LL_DMA_SetPeriphRequest(route.dma, route.channel, route.request);
+        LL_DMA_ConfigTransfer(route.dma, route.channel,
+                              LL_DMA_DIRECTION_PERIPH_TO_MEMORY |
+                              LL_DMA_MODE_CIRCULAR |
+                              LL_DMA_PERIPH_NOINCREMENT |
+                              LL_DMA_MEMORY_INCREMENT |
+                              LL_DMA_PDATAALIGN_BYTE |
+                              LL_DMA_MDATAALIGN_BYTE |
+                              LL_DMA_PRIORITY_HIGH);
+        LL_DMA_ConfigAddresses(route.dma, route.channel,
+                               reinterpret_cast<uint32_t>(&usart->RDR),
+                               reinterpret_cast<uint32_t>(rxBuffer),
+                               LL_DMA_DIRECTION_PERIPH_TO_MEMORY);
+        LL_DMA_SetDataLength(route.dma, route.channel, BUFFER_SIZE);
+
+        // Half/full transfer bound the time between position updates to half a buffer
+        LL_DMA_EnableIT_HT(route.dma, route.channel);
+        LL_DMA_EnableIT_TC(route.dma, route.channel);
+        clearDmaChannelFlags(route);
+        LL_DMA_EnableChannel(route.dma, route.channel);
+
+        // End of burst is signalled by the idle line, errors by EIE
+        WRITE_REG(usart->ICR, USART_ICR_IDLECF | USART_ICR_ORECF | USART_ICR_NECF | USART_ICR_FECF);
+        SET_BIT(usart->CR3, USART_CR3_DMAR | USART_CR3_EIE);
+        SET_BIT(usart->CR1, USART_CR1_IDLEIE);
+
+        NVIC_SetPriority(route.irqn, NVIC_EncodePriority(NVIC_GetPriorityGrouping(), 0, 0));
+        NVIC_EnableIRQ(route.irqn);
+    }
+
+    template<uint16_t BUFFER_SIZE>
+    void UsartDriver<BUFFER_SIZE>::updateRxPosition() {
+        const DmaRoute route = getRxDmaRoute(peripheralType);
+
+        // CNDTR counts down and reloads in circular mode
+        uint16_t position = static_cast<uint16_t>(BUFFER_SIZE - LL_DMA_GetDataLength(route.dma, route.channel));
+        if (position >= BUFFER_SIZE) {
+            position = 0;
+        }
+
+        const uint16_t received = static_cast<uint16_t>((position - rxDmaPosition) & (BUFFER_SIZE - 1));
+        rxDmaPosition = position;
+        rxWritten = rxWritten + received;
+    }
+
+    template<uint16_t BUFFER_SIZE>
+    uint16_t UsartDriver<BUFFER_SIZE>::receive(uint8_t* data, uint16_t maxLength) {
+        if (data == nullptr || maxLength == 0) return 0;
+
+        uint32_t written;
+        {
+            CriticalSection lock;
+            updateRxPosition();
+            written = rxWritten;
+        }
+
+        uint32_t available = written - rxRead;
+        if (available > BUFFER_SIZE) {
+            // DMA lapped the reader: keep the newest BUFFER_SIZE bytes
+            rxOverruns = rxOverruns + (available - BUFFER_SIZE);
+            rxRead = written - BUFFER_SIZE;
+            available = BUFFER_SIZE;
+        }
+
+        const uint16_t count = (available < maxLength) ? static_cast<uint16_t>(available) : maxLength;
+        const uint16_t start = static_cast<uint16_t>(rxRead & (BUFFER_SIZE - 1));
+        const uint16_t first = (count < BUFFER_SIZE - start) ? count : static_cast<uint16_t>(BUFFER_SIZE - start);
+
+        memcpy(data, &rxBuffer[start], first);
+        memcpy(data + first, &rxBuffer[0], count - first);
+        rxRead += count;
+
+        return count;
+    }
+
+    template<uint16_t BUFFER_SIZE>
+    uint16_t UsartDriver<BUFFER_SIZE>::getRxLevel() {
+        uint32_t written;
+        {
+            CriticalSection lock;
+            updateRxPosition();
+            written = rxWritten;
+        }
+
+        const uint32_t available = written - rxRead;
+        return (available > BUFFER_SIZE) ? BUFFER_SIZE : static_cast<uint16_t>(available);
     }
 
     template<uint16_t BUFFER_SIZE>
@@ -151,14 +475,7 @@ namespace USART
     uint16_t UsartDriver<BUFFER_SIZE>::sendData(const uint8_t* data, uint16_t length) {
         if (data == nullptr) return 0;
         
-        uint16_t sent = 0;
-        for (uint16_t i = 0; i < length; i++) {
-            if (txBuffer.put(data[i])) {
-                sent++;
-            } else {
-                break; // Buffer full
-            }
-        }
+        uint16_t sent = txBuffer.write(data, length);
         
         if (sent > 0 && !transmissionActive) {
             startTransmission();
@@ -171,39 +488,31 @@ namespace USART
     uint16_t UsartDriver<BUFFER_SIZE>::sendString(const char* str) {
         if (str == nullptr) return 0;
         
-        uint16_t sent = 0;
-        while (*str != '\0') {
-            if (txBuffer.put(static_cast<uint8_t>(*str))) {
-                sent++;
-                str++;
-            } else {
-                break; // Buffer full
-            }
+        size_t length = strlen(str);
+        if (length > BUFFER_SIZE) {
+            length = BUFFER_SIZE; // More than the buffer can ever hold
         }
         
-        if (sent > 0 && !transmissionActive) {
-            startTransmission();
-        }
-        
-        return sent;
+        return sendData(reinterpret_cast<const uint8_t*>(str), static_cast<uint16_t>(length));
     }
 
     template<uint16_t BUFFER_SIZE>
     uint16_t UsartDriver<BUFFER_SIZE>::sendFormatted(const char* format, ...) {
         if (format == nullptr) return 0;
         
-        char buffer[256]; // Temporary buffer for formatted string
+        // Render straight into the TX ring; no line buffer, no heap
+        FORMAT::StreamFormatter<CircularBuffer<BUFFER_SIZE>> formatter(txBuffer);
         va_list args;
         va_start(args, format);
-        int length = vsnprintf(buffer, sizeof(buffer), format, args);
+        formatter.vformat(format, args);
         va_end(args);
+        uint16_t sent = formatter.finish();
         
-        if (length > 0) {
-            return sendData(reinterpret_cast<const uint8_t*>(buffer), 
-                           static_cast<uint16_t>(length));
+        if (sent > 0 && !transmissionActive) {
+            startTransmission();
         }
         
-        return 0;
+        return sent;
     }
 
     template<uint16_t BUFFER_SIZE>
@@ -212,21 +521,31 @@ namespace USART
         
         const char* hexChars = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
         uint16_t sent = 0;
+        uint16_t i = 0;
         
-        for (uint16_t i = 0; i < length; i++) {
-            uint8_t byte = data[i];
-            
-            // Send high nibble
-            if (!txBuffer.put(hexChars[(byte >> 4) & 0x0F])) {
+        // Encode straight into the free regions: at most two, one publish each
+        while (i < length) {
+            uint8_t* region;
+            uint16_t space = txBuffer.reserveContiguous(region);
+            if (space == 0) {
                 break;
             }
-            sent++;
             
-            // Send low nibble
-            if (!txBuffer.put(hexChars[byte & 0x0F])) {
-                break;
+            uint16_t written = 0;
+            while (i < length && written < space) {
+                uint8_t byte = data[i];
+                
+                // Send high nibble, then low nibble (possibly in the next region)
+                if ((sent + written) % 2 == 0) {
+                    region[written++] = hexChars[(byte >> 4) & 0x0F];
+                } else {
+                    region[written++] = hexChars[byte & 0x0F];
+                    i++;
+                }
             }
-            sent++;
+            
+            txBuffer.publish(written);
+            sent += written;
         }
         
         if (sent > 0 && !transmissionActive) {
@@ -241,21 +560,27 @@ namespace USART
         if (data == nullptr) return 0;
         
         uint16_t sent = 0;
+        const uint32_t total = static_cast<uint32_t>(length) * 8U;
         
-        for (uint16_t i = 0; i < length; i++) {
-            uint8_t byte = data[i];
+        while (sent < total) {
+            uint8_t* region;
+            uint16_t space = txBuffer.reserveContiguous(region);
+            if (space == 0) {
+                break;
+            }
             
-            // Send each bit (MSB first)
-            for (int bit = 7; bit >= 0; bit--) {
-                char bitChar = ((byte >> bit) & 0x01) ? '1' : '0';
-                if (!txBuffer.put(bitChar)) {
-                    goto exit_loops;
-                }
-                sent++;
+            uint16_t written = 0;
+            while (sent + written < total && written < space) {
+                // Each bit (MSB first)
+                uint32_t bitIndex = sent + written;
+                uint8_t byte = data[bitIndex / 8U];
+                region[written++] = ((byte >> (7U - (bitIndex % 8U))) & 0x01) ? '1' : '0';
             }
+            
+            txBuffer.publish(written);
+            sent += written;
         }
         
-    exit_loops:
         if (sent > 0 && !transmissionActive) {
             startTransmission();
         }
@@ -265,17 +590,56 @@ namespace USART
 
     template<uint16_t BUFFER_SIZE>
     void UsartDriver<BUFFER_SIZE>::startTransmission() {
-        if (txBuffer.isEmpty()) {
+        // The TX interrupt may finish a transfer between our check and the kick-off
+        CriticalSection lock;
+
+        if (transmissionActive || txBuffer.isEmpty()) {
             return;
         }
         
         transmissionActive = true;
         
-        // Get first byte and start transmission
-        uint8_t data;
-        if (txBuffer.get(data)) {
-            transmitByte(data);
+        if (config.txMode == TransferMode::DMA) {
+            transmitNextDmaRegion();
+        } else {
+            // TXE fires immediately and drains the queue from the ISR
+            enableTxInterrupt();
+        }
+    }
+
+    template<uint16_t BUFFER_SIZE>
+    void UsartDriver<BUFFER_SIZE>::transmitNextDmaRegion() {
+        const DmaRoute route = getTxDmaRoute(peripheralType);
+
+        const uint8_t* region;
+        uint16_t length = txBuffer.peekContiguous(region);
+        if (length == 0) {
+            dmaTxLength = 0;
+            transmissionActive = false;
+            if (txIdleCallback != nullptr) {
+                txIdleCallback(txIdleContext);
+            }
+            return;
         }
+
+        dmaTxLength = length;
+        transmissionActive = true;
+        LL_DMA_DisableChannel(route.dma, route.channel);
+        LL_DMA_SetMemoryAddress(route.dma, route.channel, reinterpret_cast<uint32_t>(region));
+        LL_DMA_SetDataLength(route.dma, route.channel, length);
+        LL_DMA_EnableChannel(route.dma, route.channel);
+    }
+
+    template<uint16_t BUFFER_SIZE>
+    void UsartDriver<BUFFER_SIZE>::enableTxInterrupt() {
+        USART_TypeDef* usart = static_cast<USART_TypeDef*>(usartInstance);
+        SET_BIT(usart->CR1, USART_CR1_TXEIE);
+    }
+
+    template<uint16_t BUFFER_SIZE>
+    void UsartDriver<BUFFER_SIZE>::disableTxInterrupt() {
+        USART_TypeDef* usart = static_cast<USART_TypeDef*>(usartInstance);
+        CLEAR_BIT(usart->CR1, USART_CR1_TXEIE);
     }
 
     template<uint16_t BUFFER_SIZE>
@@ -289,9 +653,8 @@ namespace USART
             case PeripheralType::USART_1:
             case PeripheralType::USART_2:
             case PeripheralType::USART_3: {
-                // TODO: Implement when USART LL drivers are available
-                [[maybe_unused]] USART_TypeDef* usart = static_cast<USART_TypeDef*>(usartInstance);
-                // usart->TDR = data; // Direct register access as fallback
+                USART_TypeDef* usart = static_cast<USART_TypeDef*>(usartInstance);
+                usart->TDR = data;
                 break;
             }
         }
@@ -322,10 +685,73 @@ namespace USART
             transmitByte(data);
         } else {
             // No more data, transmission complete
+            disableTxInterrupt();
             transmissionActive = false;
+            if (txIdleCallback != nullptr) {
+                txIdleCallback(txIdleContext);
+            }
+        }
+    }
+
+    template<uint16_t BUFFER_SIZE>
+    void UsartDriver<BUFFER_SIZE>::handleInterrupt() {
+        USART_TypeDef* usart = static_cast<USART_TypeDef*>(usartInstance);
+        const uint32_t isr = usart->ISR;
+        const uint32_t cr1 = usart->CR1;
+
+        if ((isr & USART_ISR_TXE) && (cr1 & USART_CR1_TXEIE)) {
+            handleTxCompleteInterrupt();
+        }
+
+        if (isr & (USART_ISR_ORE | USART_ISR_NE | USART_ISR_FE)) {
+            WRITE_REG(usart->ICR, USART_ICR_ORECF | USART_ICR_NECF | USART_ICR_FECF);
+            rxErrors = rxErrors + 1;
+        }
+
+        if ((isr & USART_ISR_IDLE) && (cr1 & USART_CR1_IDLEIE)) {
+            WRITE_REG(usart->ICR, USART_ICR_IDLECF);
+            updateRxPosition();
+            if (rxCallback != nullptr) {
+                rxCallback(rxContext);
+            }
         }
     }
 
+    template<uint16_t BUFFER_SIZE>
+    void UsartDriver<BUFFER_SIZE>::handleDmaTxInterrupt() {
+        const DmaRoute route = getTxDmaRoute(peripheralType);
+
+        // On transfer error the region is dropped rather than retried forever
+        clearDmaChannelFlags(route);
+
+        txBuffer.commit(dmaTxLength);
+        transmitNextDmaRegion();
+    }
+
+    template<uint16_t BUFFER_SIZE>
+    void UsartDriver<BUFFER_SIZE>::handleDmaRxInterrupt() {
+        clearDmaChannelFlags(getRxDmaRoute(peripheralType));
+        updateRxPosition();
+        if (rxCallback != nullptr) {
+            rxCallback(rxContext);
+        }
+    }
+
+    template<uint16_t BUFFER_SIZE>
+    void UsartDriver<BUFFER_SIZE>::setTxIdleCallback(EventCallback callback, void* context) {
+        // Both words change together with respect to the TX interrupts
+        CriticalSection lock;
+        txIdleCallback = callback;
+        txIdleContext = context;
+    }
+
+    template<uint16_t BUFFER_SIZE>
+    void UsartDriver<BUFFER_SIZE>::setRxCallback(EventCallback callback, void* context) {
+        CriticalSection lock;
+        rxCallback = callback;
+        rxContext = context;
+    }
+
     // Explicit template instantiations for common buffer sizes
     template class UsartDriver<64>;
     template class UsartDriver<128>;
@@ -334,16 +760,24 @@ namespace USART
     template class UsartDriver<1024>;
 
     // Global interrupt handler functions
-    void registerLpuart1Handler(void* instance) {
-        g_lpuart1Instance = instance;
+    void handleInterrupt(PeripheralType peripheral) {
+        const InterruptBinding& binding = g_interruptBindings[toIndex(peripheral)];
+        if (binding.peripheral != nullptr) {
+            binding.peripheral(binding.instance);
+        }
     }
 
-    void handleLpuart1Interrupt() {
-        // Handle LPUART1 TXE interrupt
-        if (g_lpuart1Instance != nullptr) {
-            // For now, just cast and call the interrupt handler
-            // In production, you'd want to check the actual hardware flags
-            static_cast<UsartDriver<256>*>(g_lpuart1Instance)->handleTxCompleteInterrupt();
+    void handleDmaTxInterrupt(PeripheralType peripheral) {
+        const InterruptBinding& binding = g_interruptBindings[toIndex(peripheral)];
+        if (binding.dmaTx != nullptr) {
+            binding.dmaTx(binding.instance);
+        }
+    }
+
+    void handleDmaRxInterrupt(PeripheralType peripheral) {
+        const InterruptBinding& binding = g_interruptBindings[toIndex(peripheral)];
+        if (binding.dmaRx != nullptr) {
+            binding.dmaRx(binding.instance);
         }
     }
 
@@ -351,16 +785,32 @@ namespace USART
 
 // C interface function for interrupt handling
 extern "C" {
-    void USART_HandleLpuart1Interrupt(void) {
-        USART::handleLpuart1Interrupt();
+    void USART_HandleInterrupt(uint32_t peripheral) {
+        if (peripheral < USART::PERIPHERAL_COUNT) {
+            USART::handleInterrupt(static_cast<USART::PeripheralType>(peripheral));
+        }
+    }
+
+    void USART_HandleDmaTxInterrupt(uint32_t peripheral) {
+        if (peripheral < USART::PERIPHERAL_COUNT) {
+            USART::handleDmaTxInterrupt(static_cast<USART::PeripheralType>(peripheral));
+        }
+    }
+
+    void USART_HandleDmaRxInterrupt(uint32_t peripheral) {
+        if (peripheral < USART::PERIPHERAL_COUNT) {
+            USART::handleDmaRxInterrupt(static_cast<USART::PeripheralType>(peripheral));
+        }
     }
     
     // C interface functions for syscalls integration
     void* USART_CreateDebugInstance(void) {
-        // Create LPUART1 instance for debug output
+        // Create LPUART1 instance for debug output. With its rings it is larger than any
+        // pool block, and it lives until reset, so it is built in static storage
+        alignas(USART::StandardUSART) static uint8_t storage[sizeof(USART::StandardUSART)];
         static USART::StandardUSART* debug_instance = nullptr;
         if (debug_instance == nullptr) {
-            debug_instance = new USART::StandardUSART(USART::PeripheralType::LPUART_1);
+            debug_instance = new (storage) USART::StandardUSART(USART::PeripheralType::LPUART_1);
         }
         return debug_instance;
     }
@@ -372,17 +822,20 @@ extern "C" {
         c_config.wordLength = cpp_config.wordLength;
         c_config.stopBits = cpp_config.stopBits;
         c_config.parity = cpp_config.parity;
+        c_config.useDma = (cpp_config.txMode == USART::TransferMode::DMA) ? 1U : 0U;
         return &c_config;
     }
     
     void USART_Initialize(void* instance, void* config_ptr) {
         if (instance != nullptr && config_ptr != nullptr) {
             USART_Config* config = static_cast<USART_Config*>(config_ptr);
-            USART::Config cpp_config;
+            // Start from defaults so fields without a C counterpart are defined
+            USART::Config cpp_config = USART::getDefaultLpuartConfig();
             cpp_config.baudRate = config->baudRate;
             cpp_config.wordLength = config->wordLength;
             cpp_config.stopBits = config->stopBits;
             cpp_config.parity = config->parity;
+            cpp_config.txMode = config->useDma ? USART::TransferMode::DMA : USART::TransferMode::INTERRUPT;
             
             static_cast<USART::StandardUSART*>(instance)->initialize(cpp_config);
         }
@@ -393,4 +846,12 @@ extern "C" {
             static_cast<USART::StandardUSART*>(instance)->sendByte(static_cast<uint8_t>(c));
         }
     }
+
+    int USART_Receive(void* instance, char* buffer, int length) {
+        if (instance == nullptr || buffer == nullptr || length <= 0) {
+            return 0;
+        }
+        const uint16_t maxLength = (length > 0xFFFF) ? 0xFFFFU : static_cast<uint16_t>(length);
+        return static_cast<USART::StandardUSART*>(instance)->receive(reinterpret_cast<uint8_t*>(buffer), maxLength);
+    }
 }
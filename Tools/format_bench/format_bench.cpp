@@ -0,0 +1,237 @@
+/**
+ * @file    format_bench.cpp
+ * @brief   Host benchmark: FORMAT::StreamFormatter vs. vsnprintf + ring copy
+ *
+ * Build and run on the development machine:
+ * @code
+ *   g++ -O2 -std=c++17 -I../../Utils/Inc format_bench.cpp -o format_bench && ./format_bench
+ * @endcode
+ *
+ * The ring below mirrors the producer/consumer API of USART::CircularBuffer so the
+ * formatter runs exactly the code path used by UsartDriver::sendFormatted(). Every
+ * case is also checked byte for byte against snprintf before it is timed.
+ *
+ * Acceptance: at least 5x over the four log lines (best of 40 alternating rounds).
+ * Measured on an x86-64 host against glibc at -O2: 5.2x to 5.3x over repeated
+ * runs (about 890 ns vs. 170 ns per 4 lines).
+ */
+
+#include "StreamFormatter.h"
+
+#include <chrono>
+#include <cstdio>
+
+#ifndef __DMB
+#define __DMB() __asm__ volatile("" ::: "memory")
+#endif
+
+/**
+ * @brief Host copy of the CircularBuffer producer/consumer interface
+ */
+template<uint16_t SIZE>
+class Ring {
+private:
+    static constexpr uint16_t MASK = SIZE - 1;
+    uint8_t buffer[SIZE];
+    volatile uint16_t head = 0;
+    volatile uint16_t tail = 0;
+
+public:
+    uint16_t reserveContiguous(uint8_t*& data) {
+        const uint16_t currentHead = head;
+        const uint16_t free = (tail - currentHead - 1) & MASK;
+        const uint16_t toEnd = SIZE - currentHead;
+        data = &buffer[currentHead];
+        return (free < toEnd) ? free : toEnd;
+    }
+
+    void publish(uint16_t count) {
+        __DMB();
+        head = (head + count) & MASK;
+    }
+
+    // Byte-wise put, as the old sendFormatted() path did through sendData()
+    bool put(uint8_t data) {
+        const uint16_t nextHead = (head + 1) & MASK;
+        if (nextHead == tail) {
+            return false;
+        }
+        buffer[head] = data;
+        head = nextHead;
+        return true;
+    }
+
+    // Consume everything without copying (models the DMA engine taking the data)
+    uint16_t discard() {
+        const uint16_t count = (head - tail) & MASK;
+        tail = head;
+        return count;
+    }
+
+    uint16_t drain(char* out) {
+        uint16_t count = 0;
+        while (tail != head) {
+            out[count++] = static_cast<char>(buffer[tail]);
+            tail = (tail + 1) & MASK;
+        }
+        return count;
+    }
+};
+
+using BenchRing = Ring<512>;
+
+static uint16_t sendWithVsnprintf(BenchRing& ring, const char* format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    uint16_t sent = 0;
+    for (int i = 0; i < length && ring.put(static_cast<uint8_t>(buffer[i])); i++) {
+        sent++;
+    }
+    return sent;
+}
+
+static uint16_t sendWithFormatter(BenchRing& ring, const char* format, ...) {
+    FORMAT::StreamFormatter<BenchRing> formatter(ring);
+    va_list args;
+    va_start(args, format);
+    formatter.vformat(format, args);
+    va_end(args);
+    return formatter.finish();
+}
+
+// Typical log lines; both functions receive identical arguments
+#define LOG_CASES(SEND, RING, I)                                                          \
+    SEND(RING, "[%8lu] ADC ch%u = %4d mV\r\n", (unsigned long)(I), (I) & 7U, (int)((I) % 3300U)); \
+    SEND(RING, "REG 0x%08lX -> 0x%04X (%s)\r\n", 0x40013800UL + (I), (I) & 0xFFFFU, "ok"); \
+    SEND(RING, "temp=%.2f C, err=%-6d|\r\n", 21.5 + ((I) % 100) * 0.01, -(int)(I));       \
+    SEND(RING, "state %s -> %s, retries %3u%%\r\n", "IDLE", "RUNNING", (I) % 100U)
+
+static volatile uint32_t sink;
+
+// One round of iterations, in ns per call
+template<typename Send>
+static double timeRound(Send send, uint32_t iterations) {
+    BenchRing ring;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        send(ring, i);
+        sink = sink + ring.discard();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / iterations;
+}
+
+// Best of several rounds; the two paths alternate so machine noise hits both alike
+template<typename Baseline, typename Streaming>
+static void measure(Baseline baselineSend, Streaming streamingSend, uint32_t iterations,
+                    double& baseline, double& streaming) {
+    baseline = 1e30;
+    streaming = 1e30;
+    for (uint32_t round = 0; round < 40; round++) {
+        const double a = timeRound(baselineSend, iterations);
+        const double b = timeRound(streamingSend, iterations);
+        if (a < baseline) {
+            baseline = a;
+        }
+        if (b < streaming) {
+            streaming = b;
+        }
+    }
+}
+
+static bool check(const char* expected, BenchRing& ring) {
+    char out[512];
+    const uint16_t length = ring.drain(out);
+    out[length] = '\0';
+    if (strcmp(out, expected) != 0) {
+        printf("MISMATCH\n  snprintf : \"%s\"\n  formatter: \"%s\"\n", expected, out);
+        return false;
+    }
+    return true;
+}
+
+#define CHECK(...)                                                 \
+    do {                                                           \
+        char expected[256];                                        \
+        snprintf(expected, sizeof(expected), __VA_ARGS__);         \
+        sendWithFormatter(ring, __VA_ARGS__);                      \
+        ok &= check(expected, ring);                               \
+    } while (0)
+
+int main() {
+    BenchRing ring;
+    bool ok = true;
+
+    // Fill the ring partially first so output straddles the wrap point
+    for (uint32_t offset = 0; offset < 512; offset += 37) {
+        char scratch[512];
+        for (uint32_t i = 0; i < offset; i++) {
+            ring.put('x');
+        }
+        ring.drain(scratch);
+
+        CHECK("%d %i %u", 0, -2147483647 - 1, 4294967295U);
+        CHECK("%5d|%-5d|%05d|%+d|% d", 42, 42, -42, 7, 7);
+        CHECK("%x %X %#x %#o %o %08X", 0xBEEFU, 0xBEEFU, 255U, 8U, 0U, 0xABCU);
+        CHECK("%.3d %.0d|%8.3d", 5, 0, -12);
+        CHECK("%lld %llu %llx", -9223372036854775807LL - 1, 18446744073709551615ULL, 0x123456789ABCDEFULL);
+        CHECK("%zu %ld %lu %hu %hhd", sizeof(int), -123456L, 123456UL, 65535, 12);
+        CHECK("%hhd %hhu %hd %hu %hx %hhX", 300, -1, 70000, -1, 0x12345, 0x1FF);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat"   // Sign flags on unsigned conversions are ignored on purpose
+        CHECK("%+u|% u|%+x|% o|%+d|% i", 7U, 7U, 7U, 7U, 7, 7);
+#pragma GCC diagnostic pop
+        CHECK("%s|%10s|%-10s|%.3s|%*s|%-*s|", "abc", "right", "left", "truncate", 6, "w", 6, "w");
+        CHECK("%c%c%3c%-3c|", 'a', 'b', 'c', 'd');
+        CHECK("%f %.2f %.0f %8.3f %-8.1f| %+.1f", 3.14159, -2.005, 2.6, 1.0005, 9.96, 0.05);
+        CHECK("%.4f %010.3f", 123456.78901, -3.5);
+        CHECK("%.12f %.19f %.22f|%#.0f %#x", 0.1, 0.25, 1.5, 3.0, 0U);
+        CHECK("%e %.3E %.0e %12.4e|%-12.2e|%+e", 12345.678, -0.000123456, 9.6, 6.02214076e23, 1.6e-19, 0.0);
+        CHECK("%e %e %.2e %e", 1e300, 2.2250738585072014e-308, 9.999, 1e-5);
+        CHECK("%g %g %g %g %g %g", 100000.0, 1000000.0, 0.0001, 0.00001, 123.456, 0.0);
+        CHECK("%.3g %.10g %G %#g %-10g| %+g %8.2g", 3.14159, 2.0 / 3.0, 1.5e-10, 1.5, 42.0, 7.0, 1234.5);
+        CHECK("%g %f %e %F %E", 1.0 / 0.0, -1.0 / 0.0, __builtin_nan(""), 1.0 / 0.0, 1.0 / 0.0);
+        CHECK("100%% done %p", reinterpret_cast<void*>(0x20001000));
+    }
+
+    // Fixed-point (Q16.16) against the floating-point reference
+    const int32_t samples[] = { 0, 1 << 16, -(1 << 15), 0x0003243F, -0x0003243F, 0x7FFFFFFF, 123 };
+    for (int32_t raw : samples) {
+        char expected[64];
+        snprintf(expected, sizeof(expected), "%.4f", raw / 65536.0);
+        FORMAT::StreamFormatter<BenchRing> formatter(ring);
+        formatter.putFixed(raw, 16, 4);
+        formatter.finish();
+        ok &= check(expected, ring);
+    }
+
+    // Truncation: a full ring drops the tail and reports it
+    {
+        FORMAT::StreamFormatter<BenchRing> formatter(ring);
+        for (int i = 0; i < 100; i++) {
+            formatter.format("%08X", 0xDEADBEEFU);
+        }
+        const uint16_t written = formatter.finish();
+        char out[512];
+        ok &= (written == 511) && formatter.isTruncated() && (ring.drain(out) == 511);
+    }
+
+    printf("correctness: %s\n", ok ? "PASS" : "FAIL");
+
+    const uint32_t iterations = 20000;
+    double baseline;
+    double streaming;
+    measure([](BenchRing& r, uint32_t i) { LOG_CASES(sendWithVsnprintf, r, i); },
+            [](BenchRing& r, uint32_t i) { LOG_CASES(sendWithFormatter, r, i); },
+            iterations, baseline, streaming);
+
+    printf("vsnprintf + ring copy : %8.1f ns per 4 lines\n", baseline);
+    printf("StreamFormatter       : %8.1f ns per 4 lines\n", streaming);
+    printf("speedup               : %8.2fx\n", baseline / streaming);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+"""
+Decoder for the deferred log frames produced by LOG_MSG (Utils/Inc/Log.h).
+
+The format strings never reach the target; they live in the ".log_strings"
+section of the firmware ELF. Each frame on the wire is
+
+    COBS( varint(id) argument* ) 0x00
+
+where id is the address of the format string in ".log_strings". The argument
+encoding is selected by the conversion in the format string:
+
+    %d %i               varint of the 32-bit pattern, printed signed
+    %u %x %X %o %c %p   varint of the 32-bit pattern
+    %lld %llu ... %j    varint of the 64-bit pattern
+    %f %e %g ...        4 byte IEEE-754 single, little endian
+    %s                  varint length + bytes
+
+String ID 0 is never an address in ".log_strings" (the section starts at 1).
+It marks raw text written through printf, COBS( varint(0) text ) 0x00, which
+is printed as it is.
+
+Usage:
+    log_decode.py firmware.elf capture.bin          # decode a capture file
+    log_decode.py firmware.elf /dev/ttyACM0 -b 115200   # live (needs pyserial)
+    cat capture.bin | log_decode.py firmware.elf -  # stdin
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SECTION_NAME = ".log_strings"
+TEXT_RECORD_ID = 0
+
+CONVERSION = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<precision>\*|\d+))?"
+    r"(?P<length>hh|h|ll|l|z|j|t)?(?P<conversion>[diouxXcspfFeEgG%])"
+)
+
+
+def load_strings(elf_path):
+    """Return (address, bytes) of the .log_strings section of an ELF file."""
+    with open(elf_path, "rb") as elf:
+        image = elf.read()
+
+    if image[:4] != b"\x7fELF":
+        raise ValueError(f"{elf_path}: not an ELF file")
+    is_64 = image[4] == 2
+    endian = "<" if image[5] == 1 else ">"
+
+    if is_64:
+        shoff, = struct.unpack_from(endian + "Q", image, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", image, 0x3A)
+        header = endian + "IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from(endian + "I", image, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", image, 0x2E)
+        header = endian + "IIIIIIIIII"
+
+    sections = [struct.unpack_from(header, image, shoff + i * shentsize) for i in range(shnum)]
+    names_offset = sections[shstrndx][4]
+
+    for name, _type, _flags, addr, offset, size, *_ in sections:
+        end = image.index(b"\0", names_offset + name)
+        if image[names_offset + name:end].decode() == SECTION_NAME:
+            return addr, image[offset:offset + size]
+
+    raise ValueError(f"{elf_path}: no {SECTION_NAME} section (deferred logging disabled?)")
+
+
+class StringTable:
+    def __init__(self, base, data):
+        self.base = base
+        self.data = data
+
+    def lookup(self, string_id):
+        offset = string_id - self.base
+        if offset < 0 or offset >= len(self.data):
+            return None
+        end = self.data.find(b"\0", offset)
+        return self.data[offset:end].decode(errors="replace")
+
+
+def cobs_decode(frame):
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame):
+            raise ValueError("corrupt COBS frame")
+        out += frame[i + 1:i + code]
+        i += code
+        if i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+class Reader:
+    def __init__(self, payload):
+        self.payload = payload
+        self.pos = 0
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            if self.pos >= len(self.payload):
+                raise EOFError
+            byte = self.payload[self.pos]
+            self.pos += 1
+            value |= (byte & 0x7F) << shift
+            if byte < 0x80:
+                return value
+            shift += 7
+
+    def bytes(self, count):
+        if self.pos + count > len(self.payload):
+            raise EOFError
+        data = self.payload[self.pos:self.pos + count]
+        self.pos += count
+        return data
+
+
+def render(fmt, reader):
+    """Apply the printf format to the encoded arguments."""
+    pieces = []
+    last = 0
+    for match in CONVERSION.finditer(fmt):
+        pieces.append(fmt[last:match.start()])
+        last = match.end()
+
+        conversion = match.group("conversion")
+        if conversion == "%":
+            pieces.append("%")
+            continue
+
+        flags = match.group("flags") or ""
+        width = match.group("width") or ""
+        precision = match.group("precision")
+        if width == "*":
+            width = str(signed32(reader.varint()))
+        if precision == "*":
+            precision = str(signed32(reader.varint()))
+        spec = "%" + flags + width + ("." + precision if precision is not None else "")
+
+        wide = match.group("length") in ("ll", "j")
+        try:
+            if conversion in "di":
+                value = reader.varint()
+                value = signed64(value) if wide else signed32(value)
+                pieces.append((spec + "d") % value)
+            elif conversion in "ouxX":
+                pieces.append((spec + conversion) % reader.varint())
+            elif conversion == "c":
+                pieces.append((spec + "c") % chr(reader.varint() & 0xFF))
+            elif conversion == "p":
+                pieces.append((spec + "s") % ("0x%x" % reader.varint()))
+            elif conversion == "s":
+                text = reader.bytes(reader.varint()).decode(errors="replace")
+                pieces.append((spec + "s") % text)
+            else:
+                value, = struct.unpack("<f", reader.bytes(4))
+                pieces.append((spec + conversion) % value)
+        except EOFError:
+            pieces.append("<truncated>")
+            return "".join(pieces)
+
+    pieces.append(fmt[last:])
+    return "".join(pieces)
+
+
+def signed32(value):
+    value &= 0xFFFFFFFF
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def signed64(value):
+    value &= 0xFFFFFFFFFFFFFFFF
+    return value - (1 << 64) if value & (1 << 63) else value
+
+
+def decode_frame(frame, table):
+    payload = cobs_decode(frame)
+    reader = Reader(payload)
+    string_id = reader.varint()
+    if string_id == TEXT_RECORD_ID:
+        return payload[reader.pos:].decode(errors="replace")
+    fmt = table.lookup(string_id)
+    if fmt is None:
+        return f"<unknown string id {string_id}>\n"
+    return render(fmt, reader)
+
+
+def open_input(path, baudrate):
+    if path == "-":
+        return sys.stdin.buffer
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial  # pyserial, only needed for live capture
+        return serial.Serial(path, baudrate)
+    return open(path, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode deferred LOG_MSG frames")
+    parser.add_argument("elf", help="firmware ELF containing the .log_strings section")
+    parser.add_argument("input", help="capture file, serial port or '-' for stdin")
+    parser.add_argument("-b", "--baudrate", type=int, default=115200)
+    args = parser.parse_args()
+
+    table = StringTable(*load_strings(args.elf))
+    stream = open_input(args.input, args.baudrate)
+
+    frame = bytearray()
+    while True:
+        chunk = stream.read(1) if hasattr(stream, "in_waiting") else stream.read(4096)
+        if not chunk:
+            break
+        for byte in chunk:
+            if byte != 0:
+                frame.append(byte)
+                continue
+            if frame:
+                try:
+                    sys.stdout.write(decode_frame(bytes(frame), table))
+                except (ValueError, EOFError):
+                    sys.stdout.write("<corrupt frame>\n")
+                sys.stdout.flush()
+            frame.clear()
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,112 @@
+/**
+ * @file    Arena.h
+ * @brief   Init-phase bump arena and allocation freeze
+ *
+ * Driver objects created during initialisation live until reset. Before
+ * freeze() is called, operator new serves them from a bump-pointer arena: no
+ * per-block header, no size classes, no free-list search, only an aligned
+ * pointer increment. If the arena is full, the request falls through to the
+ * MEMORY pools. Deleting an arena object is a no-op; its memory is never reused.
+ *
+ * freeze() ends the init phase. Every operator new after that is a hot-path
+ * allocation: it is counted (getHotPathAllocations()) and served from the
+ * pools. With MEMORY_FREEZE_TRAP set to 1 it stops in Error_Handler()
+ * instead, which proves the steady-state loop never allocates.
+ */
+
+#ifndef INC_ARENA_H_
+#define INC_ARENA_H_
+
+#include "main.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef MEMORY_INIT_ARENA_SIZE
+#define MEMORY_INIT_ARENA_SIZE 384U     // Bytes for init-phase objects, multiple of 8 (App.cpp asserts its objects fit)
+#endif
+
+#ifndef MEMORY_FREEZE_TRAP
+#define MEMORY_FREEZE_TRAP 0            // 1: allocation after freeze() calls Error_Handler()
+#endif
+
+namespace MEMORY
+{
+    /**
+     * @brief Arena bytes taken by an object of size bytes (rounded up to 8)
+     */
+    constexpr size_t arenaFootprint(size_t size) {
+        return (size + 7U) & ~static_cast<size_t>(7U);
+    }
+
+    /**
+     * @class Arena
+     * @brief Bump-pointer allocator without release
+     */
+    class Arena
+    {
+    public:
+        /**
+         * @param storage Array of size bytes, 8-byte aligned
+         * @param size Size in bytes
+         */
+        constexpr Arena(uint8_t* storage, size_t size)
+            : begin_(storage), end_(storage + size), next_(storage) {}
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        /**
+         * @brief Take size bytes, rounded up to 8
+         * @return Memory, or nullptr if the arena is full
+         */
+        void* allocate(size_t size);
+
+        /**
+         * @brief Check whether a pointer lies in the arena
+         */
+        bool owns(const void* pointer) const {
+            const uint8_t* address = static_cast<const uint8_t*>(pointer);
+            return address >= begin_ && address < end_;
+        }
+
+        size_t getUsed() const { return static_cast<size_t>(next_ - begin_); }
+        size_t getSize() const { return static_cast<size_t>(end_ - begin_); }
+
+    private:
+        uint8_t* const begin_;
+        uint8_t* const end_;
+        uint8_t* next_;
+    };
+
+    /**
+     * @brief Allocate from the init arena
+     * @return Memory, or nullptr once frozen or when the arena is full
+     */
+    void* allocateInit(size_t size);
+
+    /**
+     * @brief End the init phase; later allocations count as hot-path allocations
+     */
+    void freeze();
+
+    bool isFrozen();
+
+    /**
+     * @brief Record an allocation made after freeze() (traps with MEMORY_FREEZE_TRAP)
+     */
+    void noteHotPathAllocation();
+
+    /**
+     * @brief Number of allocations made after freeze()
+     */
+    uint32_t getHotPathAllocations();
+
+    /**
+     * @brief The init arena (for usage statistics and ownership checks)
+     */
+    const Arena& getInitArena();
+
+} // namespace MEMORY
+
+#endif /* INC_ARENA_H_ */
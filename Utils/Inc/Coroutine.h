@@ -0,0 +1,414 @@
+/**
+ * @file    Coroutine.h
+ * @brief   Stackless coroutine tasks with statically allocated frames
+ *
+ * A CORO::Task is a C++20 coroutine run by a CORO::Executor. Instead of polling
+ * or hand-written callbacks, sequential device logic awaits the event it needs:
+ *
+ * @code
+ * CORO::Task console(USART::StandardUSART& uart)
+ * {
+ *     char line[32];
+ *     while (true) {
+ *         co_await CORO::readLine(uart, line, sizeof(line));
+ *         uart.sendString(line);
+ *         co_await CORO::txDrained(uart);
+ *         co_await CORO::delayMs(10);
+ *     }
+ * }
+ *
+ * executor.spawn(console(uart));
+ * eventLoop.addTask(CORO::Executor::run, &executor, CORO::Executor::isReady);
+ * @endcode
+ *
+ * Tasks have no stacks: only the variables that live across a co_await are
+ * kept, in a frame of at most CORO_FRAME_SIZE bytes taken from a static pool of
+ * CORO_MAX_TASKS frames. Nothing is allocated on the heap; when the pool is
+ * exhausted or a frame is too large, the Task is invalid and spawn() fails.
+ *
+ * Wake-ups come from interrupts (EXTI callback, USART notification, TIM7 timer)
+ * and only set a bit in the executor's ready mask with LDREX/STREX; tasks
+ * always resume in thread mode from Executor::runReady(). Each suspension arms
+ * a one-shot flag first, so a wake-up racing the suspension is never lost and
+ * a late one never resumes a task waiting for something else.
+ *
+ * @note Requires C++20 coroutines (-std=c++20 or -fcoroutines); with C++17 the
+ *       header is empty.
+ */
+
+#ifndef INC_COROUTINE_H_
+#define INC_COROUTINE_H_
+
+#if defined(__cpp_impl_coroutine)
+
+#include "main.h"
+#include "timer_wheel.h"
+#include "gpio.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef CORO_MAX_TASKS
+#define CORO_MAX_TASKS 8U       // Concurrent tasks and pooled frames (at most 32)
+#endif
+
+#ifndef CORO_FRAME_SIZE
+#define CORO_FRAME_SIZE 256U    // Bytes per coroutine frame (multiple of 8)
+#endif
+
+/**
+ * @namespace CORO
+ * @brief Coroutine tasks and awaitable device events
+ */
+namespace CORO
+{
+    class Executor;
+
+    /**
+     * @class Task
+     * @brief Handle of a coroutine that has not been handed to an executor yet
+     */
+    class Task
+    {
+    public:
+        struct promise_type
+        {
+            Executor* executor = nullptr;   ///< Set by Executor::spawn()
+            uint32_t slot = 0;
+
+            Task get_return_object() noexcept { return Task(Handle::from_promise(*this)); }
+            static Task get_return_object_on_allocation_failure() noexcept { return Task(); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { Error_Handler(); }
+
+            static void* operator new(size_t size) noexcept;
+            static void operator delete(void* frame) noexcept;
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Task() = default;
+        Task(Task&& other) noexcept : handle_(other.handle_) { other.handle_ = nullptr; }
+        Task& operator=(Task&&) = delete;
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        /**
+         * @brief Destroy a coroutine that was never spawned
+         */
+        ~Task() {
+            if (handle_) {
+                handle_.destroy();
+            }
+        }
+
+        /**
+         * @brief Check whether a frame could be allocated
+         */
+        bool isValid() const { return static_cast<bool>(handle_); }
+
+    private:
+        friend class Executor;
+
+        explicit Task(Handle handle) : handle_(handle) {}
+
+        Handle handle_ = nullptr;
+    };
+
+    /**
+     * @class Executor
+     * @brief Resumes ready tasks in thread mode; wake-ups are safe from any interrupt
+     */
+    class Executor
+    {
+    public:
+        using Check = bool (*)(void* context);   ///< Completion test run in thread mode
+
+        /**
+         * @brief Construct an executor
+         * @param wheel Timer wheel for delayMs() (nullptr: delays complete at once)
+         */
+        explicit Executor(TIMER::TimerWheel* wheel = nullptr) : wheel_(wheel) {}
+
+        Executor(const Executor&) = delete;
+        Executor& operator=(const Executor&) = delete;
+
+        /**
+         * @brief Take over a task; it first runs in the next runReady()
+         * @param task Task returned by a coroutine function
+         * @return false if the task is invalid or all CORO_MAX_TASKS slots are in use
+         */
+        bool spawn(Task task);
+
+        /**
+         * @brief Resume every task that was woken (thread mode)
+         * @return Number of tasks resumed
+         */
+        uint32_t runReady();
+
+        /**
+         * @brief Check whether tasks are waiting to be resumed
+         */
+        bool hasReady() const { return ready_ != 0; }
+
+        /**
+         * @brief Number of spawned tasks that have not finished
+         */
+        uint32_t getTaskCount() const { return static_cast<uint32_t>(__builtin_popcount(used_)); }
+
+        /**
+         * @brief Timer wheel used by delayMs()
+         */
+        TIMER::TimerWheel* getWheel() const { return wheel_; }
+
+        /**
+         * @brief LOOP::EventLoop task body: runReady() on the executor in context
+         */
+        static void run(void* executor) { static_cast<Executor*>(executor)->runReady(); }
+
+        /**
+         * @brief LOOP::EventLoop ready check: hasReady() on the executor in context
+         */
+        static bool isReady(void* executor) { return static_cast<Executor*>(executor)->hasReady(); }
+
+        /**
+         * @brief Prepare a task for suspension (awaiters, before installing their hook)
+         * @param slot Task slot
+         * @param check Completion test, nullptr if any wake-up completes the wait
+         * @param context Pointer passed to check
+         */
+        void arm(uint32_t slot, Check check, void* context);
+
+        /**
+         * @brief Decide whether the task really suspends (awaiters, after installing their hook)
+         * @param slot Task slot
+         * @return false if the awaited condition already holds and the task continues
+         */
+        bool commit(uint32_t slot);
+
+        /**
+         * @brief Wake an armed task (any context); ignored if not armed
+         * @param slot Task slot
+         */
+        void wake(uint32_t slot);
+
+    private:
+        struct Slot
+        {
+            std::coroutine_handle<> handle;
+            Check check;
+            void* context;
+            volatile uint32_t armed;        ///< 1 while a wake-up is expected
+        };
+
+        TIMER::TimerWheel* wheel_;
+        Slot slots_[CORO_MAX_TASKS] = {};
+        volatile uint32_t ready_ = 0;       ///< Bit n = slot n to be resumed
+        uint32_t used_ = 0;                 ///< Bit n = slot n holds a task
+
+        bool disarm(uint32_t slot);
+        void setReady(uint32_t slot);
+    };
+
+    /**
+     * @class Awaiter
+     * @brief Base of the awaitables: binds to the suspending task's executor slot
+     */
+    class Awaiter
+    {
+    protected:
+        Executor* executor_ = nullptr;
+        uint32_t slot_ = 0;
+
+        void arm(Task::Handle handle, Executor::Check check = nullptr, void* context = nullptr) {
+            executor_ = handle.promise().executor;
+            slot_ = handle.promise().slot;
+            executor_->arm(slot_, check, context);
+        }
+
+        bool commit() { return executor_->commit(slot_); }
+
+        /**
+         * @brief Wake-up from an interrupt callback; context is the Awaiter
+         */
+        static void wakeFromInterrupt(void* context) {
+            Awaiter* awaiter = static_cast<Awaiter*>(context);
+            awaiter->executor_->wake(awaiter->slot_);
+        }
+    };
+
+    //=========================================================================
+    // Awaitables
+    //=========================================================================
+
+    /**
+     * @brief Let the other ready tasks run, then continue
+     */
+    class YieldAwaiter : public Awaiter
+    {
+    public:
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(Task::Handle handle) {
+            arm(handle);
+            executor_->wake(slot_);
+            return true;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    inline YieldAwaiter yield() { return YieldAwaiter{}; }
+
+    /**
+     * @brief Sleep on the executor's timer wheel without blocking other tasks
+     */
+    class DelayAwaiter : public Awaiter
+    {
+    public:
+        explicit DelayAwaiter(uint32_t ticks) : ticks_(ticks) {}
+
+        bool await_ready() const noexcept { return ticks_ == 0; }
+        bool await_suspend(Task::Handle handle) {
+            arm(handle);
+            TIMER::TimerWheel* wheel = executor_->getWheel();
+            if (wheel == nullptr) {
+                executor_->wake(slot_);
+                return commit();
+            }
+            wheel->startOneShot(timer_, ticks_);
+            return true;
+        }
+        void await_resume() const noexcept {}
+
+    private:
+        uint32_t ticks_;
+        TIMER::Timer timer_{wakeFromInterrupt, static_cast<Awaiter*>(this)};
+    };
+
+    /**
+     * @brief Sleep for a number of milliseconds (rounded up to wheel ticks)
+     */
+    inline DelayAwaiter delayMs(uint32_t ms) { return DelayAwaiter(TIMER::TimerWheel::msToTicks(ms)); }
+
+    /**
+     * @brief Wait for the next interrupt edge of an EXTI pin
+     *
+     * The awaiter owns the pin's callback while waiting and removes it on
+     * resumption. co_await yields the pin level after the edge.
+     */
+    class EdgeAwaiter : public Awaiter
+    {
+    public:
+        explicit EdgeAwaiter(GPIO::GPIOEXTI& pin) : pin_(pin) {}
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(Task::Handle handle) {
+            arm(handle);
+            pin_.setCallback(wakeFromInterrupt, static_cast<Awaiter*>(this));
+            return true;
+        }
+        GPIO::PinState await_resume() {
+            pin_.setCallback(nullptr);
+            return pin_.read();
+        }
+
+    private:
+        GPIO::GPIOEXTI& pin_;
+    };
+
+    inline EdgeAwaiter edge(GPIO::GPIOEXTI& pin) { return EdgeAwaiter(pin); }
+
+    /**
+     * @brief Wait until a USART has sent everything queued (USART::UsartDriver)
+     */
+    template<typename Uart>
+    class TxDrainAwaiter : public Awaiter
+    {
+    public:
+        explicit TxDrainAwaiter(Uart& uart) : uart_(uart) {}
+
+        bool await_ready() { return isDrained(this); }
+        bool await_suspend(Task::Handle handle) {
+            arm(handle, isDrained, this);
+            uart_.setTxIdleCallback(wakeFromInterrupt, static_cast<Awaiter*>(this));
+            return commit();
+        }
+        void await_resume() { uart_.setTxIdleCallback(nullptr); }
+
+    private:
+        Uart& uart_;
+
+        static bool isDrained(void* context) {
+            const Uart& uart = static_cast<TxDrainAwaiter*>(context)->uart_;
+            return !uart.isTransmissionActive() && uart.getQueueSize() == 0;
+        }
+    };
+
+    template<typename Uart>
+    TxDrainAwaiter<Uart> txDrained(Uart& uart) { return TxDrainAwaiter<Uart>(uart); }
+
+    /**
+     * @brief Wait for a received line (USART::UsartDriver)
+     *
+     * Bytes are collected up to '\n' ('\r' is dropped) and the line is
+     * NUL-terminated without the terminator. A line longer than the buffer is
+     * returned in pieces. co_await yields the line length.
+     */
+    template<typename Uart>
+    class LineAwaiter : public Awaiter
+    {
+    public:
+        LineAwaiter(Uart& uart, char* buffer, uint16_t size)
+            : uart_(uart), buffer_(buffer), size_(size) {}
+
+        bool await_ready() { return collect(this); }
+        bool await_suspend(Task::Handle handle) {
+            arm(handle, collect, this);
+            uart_.setRxCallback(wakeFromInterrupt, static_cast<Awaiter*>(this));
+            return commit();
+        }
+        uint16_t await_resume() {
+            uart_.setRxCallback(nullptr);
+            return length_;
+        }
+
+    private:
+        Uart& uart_;
+        char* buffer_;
+        uint16_t size_;
+        uint16_t length_ = 0;
+
+        static bool collect(void* context) {
+            LineAwaiter& self = *static_cast<LineAwaiter*>(context);
+            if (self.size_ == 0) {
+                return true;
+            }
+            while (self.length_ < self.size_ - 1U) {
+                uint8_t byte;
+                if (self.uart_.receive(&byte, 1) == 0) {
+                    return false;
+                }
+                if (byte == '\n') {
+                    break;
+                }
+                if (byte != '\r') {
+                    self.buffer_[self.length_++] = static_cast<char>(byte);
+                }
+            }
+            self.buffer_[self.length_] = '\0';
+            return true;
+        }
+    };
+
+    template<typename Uart>
+    LineAwaiter<Uart> readLine(Uart& uart, char* buffer, uint16_t size) {
+        return LineAwaiter<Uart>(uart, buffer, size);
+    }
+
+} // namespace CORO
+
+#endif /* __cpp_impl_coroutine */
+
+#endif /* INC_COROUTINE_H_ */
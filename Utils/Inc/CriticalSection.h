@@ -0,0 +1,39 @@
+/**
+ * @file    CriticalSection.h
+ * @brief   RAII interrupt masking for short critical sections
+ *
+ * Saves PRIMASK, masks all configurable interrupts and restores the saved
+ * state on scope exit, so guards nest and may be used from thread mode or
+ * any interrupt. Keep the guarded code to a few instructions: it delays every
+ * interrupt, the EXTI lines included. Lock-free updates (LDREX/STREX) are
+ * preferred where a single word is enough.
+ *
+ * An interrupt that becomes pending while masked still ends a WFI inside the
+ * guard and runs as soon as the guard is destroyed.
+ */
+
+#ifndef INC_CRITICAL_SECTION_H_
+#define INC_CRITICAL_SECTION_H_
+
+#include "main.h"
+
+#include <cstdint>
+
+/**
+ * @class CriticalSection
+ * @brief Masks interrupts for the lifetime of the object
+ */
+class CriticalSection
+{
+public:
+    CriticalSection() : primask_(__get_PRIMASK()) { __disable_irq(); }
+    ~CriticalSection() { __set_PRIMASK(primask_); }
+
+    CriticalSection(const CriticalSection&) = delete;
+    CriticalSection& operator=(const CriticalSection&) = delete;
+
+private:
+    uint32_t primask_;
+};
+
+#endif /* INC_CRITICAL_SECTION_H_ */
@@ -0,0 +1,54 @@
+/**
+ * @file    CycleCounter.h
+ * @brief   DWT cycle counter access and cycle/time conversions
+ *
+ * DWT->CYCCNT counts core clock cycles (31.25 ns at 32 MHz) and wraps every
+ * 2^32 cycles (about 134 s at 32 MHz). Differences of two readings taken less
+ * than one wrap apart are exact with plain unsigned subtraction.
+ */
+
+#ifndef INC_CYCLE_COUNTER_H_
+#define INC_CYCLE_COUNTER_H_
+
+#include "main.h"
+
+#include <cstdint>
+
+/**
+ * @namespace TIME
+ * @brief Time sources and conversions
+ */
+namespace TIME
+{
+    /**
+     * @brief Start the DWT cycle counter (idempotent)
+     */
+    inline void enableCycleCounter() {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    /**
+     * @brief Current cycle count (single register load)
+     */
+    inline uint32_t cycles() {
+        return DWT->CYCCNT;
+    }
+
+    /**
+     * @brief Convert a cycle count to nanoseconds at the current core clock
+     */
+    inline uint64_t cyclesToNs(uint64_t count) {
+        return (count * 1000000000ULL) / SystemCoreClock;
+    }
+
+    /**
+     * @brief Convert a cycle count to microseconds at the current core clock
+     */
+    inline uint64_t cyclesToUs(uint64_t count) {
+        return (count * 1000000ULL) / SystemCoreClock;
+    }
+
+} // namespace TIME
+
+#endif /* INC_CYCLE_COUNTER_H_ */
@@ -0,0 +1,155 @@
+/**
+ * @file    EventLoop.h
+ * @brief   Run-to-completion event loop that sleeps between events
+ *
+ * Each pass runs the thread-context timers of a TIMER::TimerWheel and every
+ * task that has work, then the core sleeps in WFI until the next interrupt.
+ * A task has work when:
+ *
+ * - it was signalled with signal() (from any context, lock-free), or
+ * - its ready predicate returns true (e.g. "queue not empty"), or
+ * - it has no predicate: such polled tasks run once after every wake-up.
+ *
+ * The idle check runs with interrupts masked, so work posted by an ISR after
+ * the check still ends WFI (a pending interrupt wakes the core even when masked).
+ *
+ * With a timer wheel attached the loop is tickless: TIME::sleep() stretches the
+ * SysTick period while sleeping and the wheel programs TIM7 for the next
+ * deadline only. SysTick keeps counting in Sleep mode, so the time base and the
+ * idle accounting both include the time spent in WFI, as measured by
+ * TIME::sleep().
+ */
+
+#ifndef INC_EVENT_LOOP_H_
+#define INC_EVENT_LOOP_H_
+
+#include "main.h"
+#include "timer_wheel.h"
+
+#include <cstdint>
+
+#ifndef EVENT_LOOP_MAX_TASKS
+#define EVENT_LOOP_MAX_TASKS 8U         // Registered tasks, at most 32
+#endif
+
+/**
+ * @namespace LOOP
+ * @brief Main-loop scheduling
+ */
+namespace LOOP
+{
+    /**
+     * @struct Stats
+     * @brief Load figures since the last resetStats()
+     */
+    struct Stats
+    {
+        uint64_t elapsedCycles;   ///< Core cycles in the window
+        uint64_t idleCycles;      ///< Cycles spent sleeping in WFI
+        uint32_t sleeps;          ///< Number of WFI entries
+        uint32_t dispatches;      ///< Task runs (timer callbacks not included)
+    };
+
+    /**
+     * @class EventLoop
+     * @brief Dispatches ready tasks and deferred timers, sleeps when there is nothing to do
+     */
+    class EventLoop
+    {
+    public:
+        using Handler = void (*)(void* context);    ///< Task body, runs to completion
+        using Ready = bool (*)(void* context);      ///< Work check, called with interrupts masked
+
+        static constexpr int32_t INVALID_TASK = -1;
+
+        /**
+         * @brief Construct a loop
+         * @param wheel Timer wheel whose thread-context timers the loop runs
+         *              (nullptr: no timers, SysTick keeps running while idle)
+         */
+        explicit EventLoop(TIMER::TimerWheel* wheel = nullptr);
+
+        EventLoop(const EventLoop&) = delete;
+        EventLoop& operator=(const EventLoop&) = delete;
+
+        /**
+         * @brief Register a task
+         * @param handler Task body
+         * @param context Pointer passed to handler and ready
+         * @param ready Work check, must be short; nullptr runs the task after every wake-up
+         * @return Task id for signal(), INVALID_TASK if the table is full
+         * @note Lower ids run first within a pass
+         */
+        int32_t addTask(Handler handler, void* context = nullptr, Ready ready = nullptr);
+
+        /**
+         * @brief Mark a task as having work (any context)
+         * @param taskId Id returned by addTask()
+         */
+        void signal(int32_t taskId)
+        {
+            if (taskId < 0 || static_cast<uint32_t>(taskId) >= EVENT_LOOP_MAX_TASKS) {
+                return;
+            }
+            uint32_t value;
+            do {
+                value = __LDREXW(&signals_);
+            } while (__STREXW(value | (1UL << taskId), &signals_) != 0);
+        }
+
+        /**
+         * @brief Run one pass: deferred timers, then every task with work
+         * @return Number of tasks and timer callbacks run
+         */
+        uint32_t runOnce();
+
+        /**
+         * @brief Sleep in WFI unless work is pending
+         */
+        void idle();
+
+        /**
+         * @brief Alternate runOnce() and idle() forever
+         */
+        [[noreturn]] void run();
+
+        /**
+         * @brief Load figures since the last resetStats()
+         */
+        Stats getStats() const;
+
+        /**
+         * @brief Busy share of the window in tenths of a percent (0..1000)
+         */
+        uint32_t getLoadPermille() const;
+
+        /**
+         * @brief Start a new measurement window
+         */
+        void resetStats();
+
+    private:
+        struct Task
+        {
+            Handler handler;
+            Ready ready;
+            void* context;
+        };
+
+        TIMER::TimerWheel* wheel_;
+        Task tasks_[EVENT_LOOP_MAX_TASKS] = {};
+        uint32_t taskCount_ = 0;
+        volatile uint32_t signals_ = 0;     ///< Bit n = task n signalled
+
+        uint64_t windowStart_ = 0;          ///< TIME::nowCycles() at resetStats()
+        uint64_t idleCycles_ = 0;
+        uint32_t sleeps_ = 0;
+        uint32_t dispatches_ = 0;
+
+        bool hasWork();
+        uint32_t takeSignals();
+    };
+
+} // namespace LOOP
+
+#endif /* INC_EVENT_LOOP_H_ */
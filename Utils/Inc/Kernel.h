@@ -0,0 +1,251 @@
+/**
+ * @file    Kernel.h
+ * @brief   Small preemptive fixed-priority kernel for the Cortex-M4F
+ *
+ * Threads have a fixed base priority from 1 (lowest) to KERNEL_MAX_PRIORITY;
+ * the highest-priority ready thread always runs, threads of equal priority run
+ * in FIFO order and share the CPU with yield(). Context switches happen in
+ * PendSV at the lowest exception priority, so they never delay an interrupt:
+ * an ISR that wakes a thread (mutex hand-over, sleep expiry) only pends PendSV,
+ * and the switch follows when the last nested ISR returns.
+ *
+ * - The code that calls start() becomes the main thread (priority
+ *   KERNEL_MAIN_PRIORITY) and keeps running on the MSP; other threads run on
+ *   the PSP with stacks placed in RAM2 by KERNEL_THREAD_STACK.
+ * - FPU registers are stacked lazily: the hardware reserves S0-S15 only for
+ *   threads that used the FPU, and PendSV saves S16-S31 only for those threads.
+ * - Mutex implements priority inheritance (transitively along chains of
+ *   blocked owners), so a long low-priority section holding a lock cannot
+ *   delay a high-priority thread behind unrelated medium-priority work.
+ * - sleepMs() uses a one-shot TIMER::Timer per thread, so the kernel adds no
+ *   periodic tick of its own.
+ * - Thread stacks are painted at construction; STACK::printUsage() reports
+ *   their high-water marks.
+ *
+ * @code
+ * KERNEL_THREAD_STACK static uint32_t flashStack[256];
+ * static KERNEL::Thread flashThread(flashWriter, nullptr, flashStack, 2);
+ *
+ * KERNEL::start(&timerWheel);
+ * flashThread.start();
+ * @endcode
+ *
+ * @note Threads run privileged; kernel calls other than start() must not be
+ *       made from interrupt handlers.
+ */
+
+#ifndef INC_KERNEL_H_
+#define INC_KERNEL_H_
+
+#include "main.h"
+#include "timer_wheel.h"
+
+#include <cstdint>
+
+#ifndef KERNEL_MAX_PRIORITY
+#define KERNEL_MAX_PRIORITY 31U         // Highest thread priority (at most 31)
+#endif
+
+#ifndef KERNEL_MAIN_PRIORITY
+#define KERNEL_MAIN_PRIORITY 1U         // Priority of the thread that calls start()
+#endif
+
+#ifndef KERNEL_IDLE_STACK_WORDS
+#define KERNEL_IDLE_STACK_WORDS 64U     // Stack of the internal idle thread
+#endif
+
+/**
+ * @brief Place a thread stack array in RAM2 (.thread_stacks, not initialised)
+ */
+#define KERNEL_THREAD_STACK __attribute__((section(".thread_stacks"), aligned(8)))
+
+/**
+ * @namespace KERNEL
+ * @brief Preemptive threads and mutexes
+ */
+namespace KERNEL
+{
+    class Mutex;
+
+    /**
+     * @enum ThreadState
+     * @brief Scheduling state of a thread
+     */
+    enum class ThreadState : uint8_t
+    {
+        CREATED,      ///< Constructed, start() not called
+        READY,        ///< Waiting for the CPU
+        RUNNING,      ///< Selected to run
+        SLEEPING,     ///< In sleepMs()
+        BLOCKED,      ///< Waiting for a mutex
+        TERMINATED    ///< Entry function returned
+    };
+
+    /**
+     * @class Thread
+     * @brief Thread control block with a caller-provided stack
+     */
+    class Thread
+    {
+    public:
+        using Entry = void (*)(void* argument);   ///< Thread function
+
+        /**
+         * @brief Construct a thread and prepare its initial stack frame
+         * @param entry Thread function; returning from it terminates the thread
+         * @param argument Pointer passed to entry
+         * @param stack Stack array, normally declared with KERNEL_THREAD_STACK
+         * @param priority Base priority (1..KERNEL_MAX_PRIORITY)
+         * @param name Name for debugging
+         */
+        template<uint32_t WORDS>
+        Thread(Entry entry, void* argument, uint32_t (&stack)[WORDS], uint8_t priority, const char* name = nullptr)
+            : Thread(entry, argument, stack, WORDS, priority, name) {}
+
+        Thread(Entry entry, void* argument, uint32_t* stack, uint32_t stackWords, uint8_t priority, const char* name = nullptr);
+
+        Thread(const Thread&) = delete;
+        Thread& operator=(const Thread&) = delete;
+
+        /**
+         * @brief Make the thread ready; it runs as soon as it is the highest-priority ready thread
+         */
+        void start();
+
+        /**
+         * @brief Current priority, raised while it holds a mutex a higher-priority thread waits for
+         */
+        uint8_t getPriority() const { return priority_; }
+
+        /**
+         * @brief Priority given at construction
+         */
+        uint8_t getBasePriority() const { return basePriority_; }
+
+        ThreadState getState() const { return state_; }
+        const char* getName() const { return name_; }
+
+        /**
+         * @brief Lowest address of the stack (for stack usage checks)
+         */
+        const uint32_t* getStackBase() const { return stackBase_; }
+        uint32_t getStackWords() const { return stackWords_; }
+
+        /**
+         * @brief Next constructed thread (see firstThread())
+         */
+        const Thread* getNextThread() const { return nextThread_; }
+
+    private:
+        friend class Mutex;
+        friend struct Scheduler;
+
+        uint32_t* sp_;                  ///< Saved stack pointer, must stay the first member (PendSV)
+        Thread* next_ = nullptr;        ///< Ready queue or mutex wait list
+        Mutex* waitingOn_ = nullptr;    ///< Mutex the thread is blocked on
+        Mutex* held_ = nullptr;         ///< Mutexes owned, linked through Mutex::nextHeld_
+        Thread* nextThread_ = nullptr;  ///< All constructed threads
+        uint32_t* stackBase_;
+        uint32_t stackWords_;
+        const char* name_;
+        TIMER::Timer sleepTimer_;
+        uint8_t basePriority_;
+        volatile uint8_t priority_;
+        volatile ThreadState state_ = ThreadState::CREATED;
+
+        Thread(const char* name, uint8_t priority);    ///< Main thread: runs on the current stack
+        static void onSleepExpired(void* thread);
+    };
+
+    /**
+     * @class Mutex
+     * @brief Non-recursive mutex with priority inheritance and direct hand-over
+     */
+    class Mutex
+    {
+    public:
+        Mutex() = default;
+        Mutex(const Mutex&) = delete;
+        Mutex& operator=(const Mutex&) = delete;
+
+        /**
+         * @brief Acquire, blocking while another thread owns the mutex
+         */
+        void lock();
+
+        /**
+         * @brief Acquire if free
+         * @return true if acquired
+         */
+        bool tryLock();
+
+        /**
+         * @brief Release and hand the mutex to the highest-priority waiter
+         * @note Only the owner may unlock
+         */
+        void unlock();
+
+        /**
+         * @brief Current owner, nullptr if free
+         */
+        Thread* getOwner() const { return owner_; }
+
+    private:
+        friend struct Scheduler;
+
+        Thread* owner_ = nullptr;
+        Thread* waiters_ = nullptr;     ///< Highest priority first
+        Mutex* nextHeld_ = nullptr;     ///< Owner's list of held mutexes
+    };
+
+    /**
+     * @class LockGuard
+     * @brief RAII lock of a Mutex
+     */
+    class LockGuard
+    {
+    public:
+        explicit LockGuard(Mutex& mutex) : mutex_(mutex) { mutex_.lock(); }
+        ~LockGuard() { mutex_.unlock(); }
+        LockGuard(const LockGuard&) = delete;
+        LockGuard& operator=(const LockGuard&) = delete;
+
+    private:
+        Mutex& mutex_;
+    };
+
+    /**
+     * @brief Turn the calling code into the main thread and start scheduling
+     * @param wheel Timer wheel used by sleepMs() (nullptr: sleepMs() only yields)
+     * @note Call once from thread mode, after the wheel has begun
+     */
+    void start(TIMER::TimerWheel* wheel);
+
+    /**
+     * @brief Check whether start() has been called
+     */
+    bool isRunning();
+
+    /**
+     * @brief The calling thread (nullptr before start())
+     */
+    Thread* currentThread();
+
+    /**
+     * @brief First of all constructed threads, followed through Thread::getNextThread()
+     */
+    const Thread* firstThread();
+
+    /**
+     * @brief Let ready threads of the same priority run
+     */
+    void yield();
+
+    /**
+     * @brief Block the calling thread for at least a number of milliseconds
+     */
+    void sleepMs(uint32_t ms);
+
+} // namespace KERNEL
+
+#endif /* INC_KERNEL_H_ */
@@ -0,0 +1,259 @@
+/**
+ * @file    Log.h
+ * @brief   Logging front end with a deferred (binary) mode for the debug UART
+ *
+ * LOG_MSG(format, ...) takes printf arguments. What goes over the wire depends
+ * on LOG_DEFERRED:
+ *
+ * - LOG_DEFERRED == 0: plain printf, i.e. ASCII text through _write().
+ * - LOG_DEFERRED == 1: the format string is placed in the ".log_strings" section,
+ *   which the linker script marks INFO (kept in the ELF, never loaded into flash).
+ *   Its address in that section is the string ID. Only the ID and the raw
+ *   arguments are sent, as one COBS frame terminated by 0x00:
+ *
+ *   @code
+ *   frame   = COBS( varint(id) argument* ) 0x00
+ *   integer = varint(32-bit pattern), varint(64-bit pattern) for 64-bit types
+ *   float   = 4 bytes IEEE-754 single, little endian (double is narrowed)
+ *   string  = varint(length) bytes
+ *   pointer = varint(address)
+ *   @endcode
+ *
+ *   Tools/log_decoder/log_decode.py turns the frames back into text using the ELF.
+ *   ID 0 is never a string address (the section starts at 1). It marks raw text
+ *   from printf/_write(), sent as COBS( varint(0) text ) 0x00 and printed verbatim.
+ *   A frame that would exceed LOG_MAX_FRAME_SIZE is dropped and counted, never cut.
+ *
+ * Integers are sent as their bit pattern, so signedness comes from the format
+ * (%d vs %u/%x), exactly as with printf. -Wformat checks the arguments in both modes.
+ *
+ * In both modes the output passes through one LOG::RecordQueue (LogQueue.h):
+ * deferred frames as one record each, printf text via _write() -> LOG_Write()
+ * (framed as above when LOG_DEFERRED == 1).
+ * Thread mode and interrupts of any priority can log concurrently; records never
+ * interleave. Interrupts are masked only briefly, when the UART transfer starts.
+ */
+
+#ifndef INC_LOG_H_
+#define INC_LOG_H_
+
+#ifndef LOG_DEFERRED
+#define LOG_DEFERRED 1
+#endif
+
+#ifndef LOG_MAX_FRAME_SIZE
+#define LOG_MAX_FRAME_SIZE 64U     // Encoded frame including COBS overhead and delimiter
+#endif
+
+#ifndef LOG_QUEUE_SIZE
+#define LOG_QUEUE_SIZE 1024U       // Record queue in front of the debug UART (power of 2)
+#endif
+
+#include <cstdint>
+
+/**
+ * @namespace LOG
+ * @brief Logging to the debug UART
+ */
+namespace LOG
+{
+    /**
+     * @brief Move committed records from the queue into the debug UART
+     * @note Safe from any context; returns at once if another context is draining
+     */
+    void flush();
+
+    /**
+     * @brief Number of records dropped because the queue was full or the frame was too long
+     */
+    uint32_t getDroppedFrames();
+
+} // namespace LOG
+
+extern "C" {
+    /**
+     * @brief Queue raw bytes (used by _write), split into records that fit the debug UART
+     * @note With LOG_DEFERRED == 1 each record is a text frame (string ID 0)
+     * @return Number of bytes queued
+     */
+    int LOG_Write(const char* data, int length);
+}
+
+#if LOG_DEFERRED
+
+#include <cstring>
+#include <type_traits>
+
+namespace LOG
+{
+    static constexpr uint32_t TEXT_RECORD_ID = 0;   ///< Raw printf text; never a .log_strings address
+
+    /**
+     * @brief COBS frame encoded on the fly (no second pass, no second buffer)
+     */
+    class Frame {
+    private:
+        static_assert(LOG_MAX_FRAME_SIZE <= 254U, "COBS blocks must stay below 254 bytes");
+
+        uint8_t data[LOG_MAX_FRAME_SIZE];
+        uint16_t length = 1;        // data[0] is the first code byte
+        uint16_t codeIndex = 0;     // Position of the open code byte
+        uint8_t code = 1;           // Distance from the open code byte
+        bool overflow = false;
+
+    public:
+        /**
+         * @brief Append one payload byte
+         */
+        void put(uint8_t byte) {
+            // Keep room for the final code byte and the delimiter
+            if (length >= LOG_MAX_FRAME_SIZE - 1U) {
+                overflow = true;
+                return;
+            }
+            if (byte == 0) {
+                data[codeIndex] = code;
+                codeIndex = length++;
+                code = 1;
+                return;
+            }
+            // Frames are shorter than 254 bytes, so a block never needs the 0xFF split
+            data[length++] = byte;
+            code++;
+        }
+
+        /**
+         * @brief Append an unsigned LEB128 varint
+         */
+        void putVarint(uint32_t value) {
+            while (value >= 0x80U) {
+                put(static_cast<uint8_t>(value | 0x80U));
+                value >>= 7;
+            }
+            put(static_cast<uint8_t>(value));
+        }
+
+        void putVarint64(uint64_t value) {
+            while (value >= 0x80U) {
+                put(static_cast<uint8_t>(value | 0x80U));
+                value >>= 7;
+            }
+            put(static_cast<uint8_t>(value));
+        }
+
+        void putFloat(float value) {
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            for (uint8_t i = 0; i < 4; i++) {
+                put(static_cast<uint8_t>(bits >> (8 * i)));
+            }
+        }
+
+        /**
+         * @brief Append a length-prefixed string, cut to what still fits
+         */
+        void putString(const char* str) {
+            if (str == nullptr) {
+                str = "(null)";
+            }
+            size_t size = strlen(str);
+            // Leave room for the length varint (up to two bytes) and the delimiter
+            const size_t room = (length + 3U < LOG_MAX_FRAME_SIZE) ? (LOG_MAX_FRAME_SIZE - length - 3U) : 0U;
+            if (size > room) {
+                size = room;
+                overflow = true;
+            }
+            putVarint(static_cast<uint32_t>(size));
+            for (size_t i = 0; i < size; i++) {
+                put(static_cast<uint8_t>(str[i]));
+            }
+        }
+
+        /**
+         * @brief Close the last COBS block and append the frame delimiter
+         * @return Encoded frame length
+         */
+        uint16_t finish() {
+            data[codeIndex] = code;
+            data[length++] = 0;
+            return length;
+        }
+
+        const uint8_t* getData() const { return data; }
+        uint16_t getLength() const { return length; }
+        bool isTruncated() const { return overflow; }
+    };
+
+    /**
+     * @brief Encode one argument by its C++ type
+     */
+    template<typename T>
+    inline void encodeArgument(Frame& frame, T value) {
+        if constexpr (std::is_floating_point<T>::value) {
+            frame.putFloat(static_cast<float>(value));
+        } else if constexpr (std::is_enum<T>::value) {
+            frame.putVarint(static_cast<uint32_t>(value));
+        } else if constexpr (std::is_integral<T>::value) {
+            if constexpr (sizeof(T) > sizeof(uint32_t)) {
+                frame.putVarint64(static_cast<uint64_t>(value));
+            } else {
+                // Sign-extends to 32 bits, the decoder picks signedness from the format
+                frame.putVarint(static_cast<uint32_t>(value));
+            }
+        } else if constexpr (std::is_same<typename std::remove_cv<typename std::remove_pointer<T>::type>::type, char>::value) {
+            frame.putString(value);
+        } else {
+            static_assert(std::is_pointer<T>::value, "LOG_MSG: unsupported argument type");
+            frame.putVarint(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(value)));
+        }
+    }
+
+    /**
+     * @brief Queue an encoded frame as one record and flush
+     * @note A truncated frame, or one that does not fit the queue, is dropped as a whole and counted
+     */
+    void send(Frame& frame);
+
+    /**
+     * @brief Encode and queue one log record
+     * @param id Address of the format string in .log_strings
+     * @param args Arguments of the format string
+     */
+    template<typename... Args>
+    inline void deferred(uintptr_t id, Args... args) {
+        Frame frame;
+        frame.putVarint(static_cast<uint32_t>(id));
+        (encodeArgument(frame, args), ...);
+        send(frame);
+    }
+
+    /**
+     * @brief Never called; lets -Wformat check LOG_MSG arguments
+     */
+    __attribute__((format(printf, 1, 2)))
+    inline void checkFormat(const char*, ...) {}
+
+} // namespace LOG
+
+/**
+ * @brief Log a printf-style message as string ID + raw arguments
+ * @note The format must be a string literal
+ */
+#define LOG_MSG(format, ...)                                                                    \
+    do {                                                                                        \
+        static const char logFormat_[] __attribute__((section(".log_strings"), used)) = format; \
+        if (false) {                                                                            \
+            LOG::checkFormat(format, ##__VA_ARGS__);                                            \
+        }                                                                                       \
+        LOG::deferred(reinterpret_cast<uintptr_t>(logFormat_), ##__VA_ARGS__);                  \
+    } while (0)
+
+#else
+
+#include <cstdio>
+
+#define LOG_MSG(format, ...) printf(format, ##__VA_ARGS__)
+
+#endif /* LOG_DEFERRED */
+
+#endif /* INC_LOG_H_ */
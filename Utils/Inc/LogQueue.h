@@ -0,0 +1,220 @@
+/**
+ * @file    LogQueue.h
+ * @brief   Lock-free multi-producer, single-consumer record queue for log output
+ *
+ * Any context (thread mode, EXTI handlers of any priority) can log at the same time:
+ *
+ * - reserve() claims a whole record by advancing the reservation counter with
+ *   LDREX/STREX. A preempting producer makes the STREX of the preempted one fail
+ *   (exception entry clears the exclusive monitor), which then simply retries.
+ * - The producer fills its record without any lock and commit()s it by writing
+ *   the record header as one 32-bit store.
+ * - drain() forwards committed records in reservation order to a sink. It runs
+ *   under a try-lock, so at most one context drains; a context that finds the lock
+ *   taken leaves its record to the holder, which re-checks before it returns.
+ *
+ * The queue itself never disables interrupts. The sink may: UsartDriver masks
+ * them while it starts a transfer (an idle check plus a DMA channel reprogram
+ * or a TXE enable, a few dozen cycles) when the UART goes from idle to busy.
+ * A record that has been reserved but not yet committed holds back the
+ * records behind it until its producer commits.
+ *
+ * Layout: records are 4-byte aligned, a header word followed by the payload.
+ * A record that would straddle the end of the buffer is preceded by a padding
+ * record filling the rest of the buffer. The consumer zeroes what it consumed, so
+ * a header word reads as "not committed" until its producer writes it.
+ */
+
+#ifndef INC_LOG_QUEUE_H_
+#define INC_LOG_QUEUE_H_
+
+#include "main.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace LOG
+{
+    /**
+     * @brief Space claimed by a producer, filled in place and handed back to commit()
+     */
+    struct Reservation {
+        uint8_t* data;      // Payload, nullptr if the queue was full
+        uint16_t length;    // Payload size as reserved
+    };
+
+    /**
+     * @brief MPSC queue of variable-length records
+     * @tparam SIZE Buffer size in bytes (power of 2, at most 32768)
+     */
+    template<uint32_t SIZE>
+    class RecordQueue {
+    private:
+        static_assert((SIZE & (SIZE - 1)) == 0 && SIZE >= 64 && SIZE <= 32768, "SIZE must be a power of 2 in [64, 32768]");
+
+        static constexpr uint32_t MASK = SIZE - 1;
+        static constexpr uint32_t HEADER_SIZE = 4;
+        static constexpr uint32_t COMMITTED = 1UL << 31;
+        static constexpr uint32_t PADDING = 1UL << 30;
+        static constexpr uint32_t LENGTH_MASK = 0xFFFFU;
+
+        alignas(4) uint8_t buffer[SIZE] = {};
+        volatile uint32_t head = 0;         // Free-running reservation counter (producers)
+        volatile uint32_t tail = 0;         // Free-running consume counter (drainer only)
+        volatile uint32_t drainLock = 0;
+        volatile uint32_t dropped = 0;
+
+        static uint32_t recordSize(uint32_t length) {
+            return HEADER_SIZE + ((length + 3U) & ~3U);
+        }
+
+        volatile uint32_t* headerAt(uint32_t position) {
+            return reinterpret_cast<volatile uint32_t*>(&buffer[position & MASK]);
+        }
+
+        bool tryLock() {
+            do {
+                if (__LDREXW(&drainLock) != 0) {
+                    __CLREX();
+                    return false;
+                }
+            } while (__STREXW(1U, &drainLock) != 0);
+            __DMB();
+            return true;
+        }
+
+        void unlock() {
+            __DMB();
+            drainLock = 0;
+        }
+
+        bool hasCommittedRecord() {
+            return (tail != head) && ((*headerAt(tail) & COMMITTED) != 0);
+        }
+
+        /**
+         * @brief Forward committed records until an uncommitted one or a full sink
+         * @return false if the sink ran out of space
+         */
+        template<typename Sink>
+        bool drainRecords(Sink& sink) {
+            uint32_t position = tail;
+            while (position != head) {
+                const uint32_t header = *headerAt(position);
+                if ((header & COMMITTED) == 0) {
+                    break;
+                }
+                __DMB();    // Payload reads after the header read
+
+                const uint32_t length = header & LENGTH_MASK;
+                if ((header & PADDING) == 0) {
+                    if (sink.getAvailableSpace() < length) {
+                        tail = position;
+                        return false;
+                    }
+                    sink.sendData(&buffer[(position + HEADER_SIZE) & MASK], static_cast<uint16_t>(length));
+                }
+
+                const uint32_t size = recordSize(length);
+                memset(&buffer[position & MASK], 0, size);
+                __DMB();    // Zeroed before producers may reuse the space
+                position += size;
+                tail = position;
+            }
+            return true;
+        }
+
+    public:
+        /**
+         * @brief Claim space for one record
+         * @param length Payload size in bytes
+         * @return Reservation; data is nullptr if the queue is full (counted as dropped)
+         */
+        Reservation reserve(uint16_t length) {
+            const uint32_t size = recordSize(length);
+            uint32_t position;
+            uint32_t padding;
+
+            do {
+                position = __LDREXW(&head);
+                const uint32_t toEnd = SIZE - (position & MASK);
+                padding = (size > toEnd) ? toEnd : 0U;
+                if (position + padding + size - tail > SIZE) {
+                    __CLREX();
+                    countDrop();
+                    return Reservation{nullptr, 0};
+                }
+            } while (__STREXW(position + padding + size, &head) != 0);
+
+            if (padding != 0) {
+                // Consumed as soon as the drainer reaches it; nothing to wait for
+                *headerAt(position) = COMMITTED | PADDING | (padding - HEADER_SIZE);
+                position += padding;
+            }
+            return Reservation{&buffer[(position + HEADER_SIZE) & MASK], length};
+        }
+
+        /**
+         * @brief Publish a filled record
+         */
+        void commit(const Reservation& record) {
+            if (record.data == nullptr) {
+                return;
+            }
+            __DMB();    // Payload visible before the header
+            *reinterpret_cast<volatile uint32_t*>(record.data - HEADER_SIZE) = COMMITTED | record.length;
+        }
+
+        /**
+         * @brief Copy a complete record into the queue
+         * @return false if the queue was full
+         */
+        bool push(const uint8_t* data, uint16_t length) {
+            const Reservation record = reserve(length);
+            if (record.data == nullptr) {
+                return false;
+            }
+            memcpy(record.data, data, length);
+            commit(record);
+            return true;
+        }
+
+        /**
+         * @brief Forward committed records to a sink, from any context
+         * @tparam Sink Provides getAvailableSpace() and sendData() (e.g. UsartDriver)
+         * @note Returns immediately if another context is draining
+         * @note Records are forwarded whole: each must fit the sink when it is empty
+         */
+        template<typename Sink>
+        void drain(Sink& sink) {
+            while (tryLock()) {
+                const bool sinkHadSpace = drainRecords(sink);
+                unlock();
+                // Records committed while we held the lock were skipped by their producer
+                if (!sinkHadSpace || !hasCommittedRecord()) {
+                    break;
+                }
+            }
+        }
+
+        /**
+         * @brief Count a record that a producer discarded before pushing it
+         */
+        void countDrop() {
+            uint32_t count;
+            do {
+                count = __LDREXW(&dropped);
+            } while (__STREXW(count + 1U, &dropped) != 0);
+        }
+
+        /**
+         * @brief Number of records rejected because the queue was full, or counted by countDrop()
+         */
+        uint32_t getDropped() const {
+            return dropped;
+        }
+    };
+
+} // namespace LOG
+
+#endif /* INC_LOG_QUEUE_H_ */
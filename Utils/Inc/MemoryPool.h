@@ -0,0 +1,172 @@
+/**
+ * @file    MemoryPool.h
+ * @brief   Fixed-block pool allocators behind operator new/delete
+ *
+ * Dynamic allocations are served from statically reserved pools of equal-size
+ * blocks, one pool per size class (16, 32, 64, 128 and 256 bytes). A request
+ * takes a block from the smallest class that fits and has one free; when
+ * that class is exhausted it spills into the next larger one.
+ *
+ * - Allocate and release are O(1) per class: a pop or push on an intrusive
+ *   free list, with untouched blocks handed out from a bump pointer. Time is
+ *   bounded by the number of classes, whatever the allocation history.
+ * - Blocks never split or merge, so the pools cannot fragment. The worst case
+ *   is that a class runs out, which getPool() makes visible.
+ * - The pools are constant-initialised, so operator new works in static
+ *   constructors of any translation unit.
+ * - The pool lists are updated with interrupts masked for a few instructions,
+ *   so threads (KERNEL) and interrupts may allocate.
+ *
+ * The block counts are compile-time settings (MEMORY_POOL_BLOCKS_xx).
+ */
+
+#ifndef INC_MEMORY_POOL_H_
+#define INC_MEMORY_POOL_H_
+
+#include "main.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef MEMORY_POOL_BLOCKS_16
+#define MEMORY_POOL_BLOCKS_16 16U       // 16-byte blocks
+#endif
+
+#ifndef MEMORY_POOL_BLOCKS_32
+#define MEMORY_POOL_BLOCKS_32 16U       // 32-byte blocks
+#endif
+
+#ifndef MEMORY_POOL_BLOCKS_64
+#define MEMORY_POOL_BLOCKS_64 8U        // 64-byte blocks
+#endif
+
+#ifndef MEMORY_POOL_BLOCKS_128
+#define MEMORY_POOL_BLOCKS_128 8U       // 128-byte blocks
+#endif
+
+#ifndef MEMORY_POOL_BLOCKS_256
+#define MEMORY_POOL_BLOCKS_256 4U       // 256-byte blocks
+#endif
+
+/**
+ * @namespace MEMORY
+ * @brief Deterministic dynamic memory
+ */
+namespace MEMORY
+{
+    /**
+     * @brief Block size of the largest class; larger objects need static storage
+     */
+    constexpr size_t MAX_BLOCK_SIZE = 256U;
+
+    /**
+     * @brief Whether operator new can serve an object of type T from the pools
+     *
+     * Assert it next to every new of a driver object, so a class that grows past
+     * the largest block fails the build instead of trapping at boot.
+     */
+    template<typename T>
+    constexpr bool fitsPool() {
+        return sizeof(T) <= MAX_BLOCK_SIZE && alignof(T) <= 8U;
+    }
+
+    /**
+     * @class BlockPool
+     * @brief Pool of equal-size blocks in caller-provided storage
+     */
+    class BlockPool
+    {
+    public:
+        /**
+         * @param storage Array of blockSize * blockCount bytes, 8-byte aligned
+         * @param blockSize Block size, a multiple of 8
+         * @param blockCount Number of blocks
+         */
+        constexpr BlockPool(uint8_t* storage, size_t blockSize, uint32_t blockCount)
+            : begin_(storage), end_(storage + blockSize * blockCount),
+              unused_(storage), blockSize_(blockSize), blockCount_(blockCount) {}
+
+        BlockPool(const BlockPool&) = delete;
+        BlockPool& operator=(const BlockPool&) = delete;
+
+        /**
+         * @brief Take a block
+         * @return Block, or nullptr if the pool is exhausted
+         */
+        void* allocate();
+
+        /**
+         * @brief Return a block obtained from allocate()
+         */
+        void release(void* block);
+
+        /**
+         * @brief Check whether a pointer lies in this pool's storage
+         */
+        bool owns(const void* pointer) const {
+            const uint8_t* address = static_cast<const uint8_t*>(pointer);
+            return address >= begin_ && address < end_;
+        }
+
+        size_t getBlockSize() const { return blockSize_; }
+        uint32_t getBlockCount() const { return blockCount_; }
+        uint32_t getUsed() const { return used_; }
+
+        /**
+         * @brief Highest number of blocks in use at the same time
+         */
+        uint32_t getPeak() const { return peak_; }
+
+        /**
+         * @brief Allocations that found the pool empty (spilled or failed)
+         */
+        uint32_t getExhausted() const { return exhausted_; }
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        uint8_t* const begin_;
+        uint8_t* const end_;
+        uint8_t* unused_;               ///< Blocks from here on were never handed out
+        FreeBlock* free_ = nullptr;     ///< Released blocks
+        const size_t blockSize_;
+        const uint32_t blockCount_;
+        uint32_t used_ = 0;
+        uint32_t peak_ = 0;
+        uint32_t exhausted_ = 0;
+    };
+
+    /**
+     * @brief Allocate from the smallest size class with a free block
+     * @return Block of at least size bytes, 8-byte aligned, or nullptr
+     */
+    void* allocate(size_t size);
+
+    /**
+     * @brief Return a block to its pool
+     * @note Calls Error_Handler() for a pointer that no pool owns
+     */
+    void release(void* block);
+
+    /**
+     * @brief Size of the pool block holding a pointer
+     * @return Block size, 0 if no pool owns the pointer
+     */
+    size_t getAllocationSize(const void* block);
+
+    /**
+     * @brief Number of size classes
+     */
+    uint32_t getPoolCount();
+
+    /**
+     * @brief Pool of a size class, smallest first (for statistics)
+     */
+    const BlockPool& getPool(uint32_t index);
+
+} // namespace MEMORY
+
+#endif /* INC_MEMORY_POOL_H_ */
@@ -0,0 +1,55 @@
+/**
+ * @file    MemorySections.h
+ * @brief   Placement of objects in SRAM2
+ *
+ * SRAM2 (16 KB at 0x10000000) is separate from the 48 KB main RAM. Placing
+ * CPU-only buffers there leaves the main RAM to the application:
+ *
+ * - RAM2_BSS: zeroed by the reset handler like .bss (section .ram2_bss).
+ *   Objects with constructors are built as usual, after the zeroing. Nothing
+ *   is copied from flash, so a constant non-zero initialiser is lost.
+ * - RAM2_NOINIT: never written at start-up (section .ram2_noinit; .noinit
+ *   input sections go there as well), so the contents survive a system reset.
+ *   With enableStandbyRetention() they also survive Standby. After power-on
+ *   the contents are random, so retained data needs its own validity marker.
+ *   It is placed first in SRAM2, so its address stays the same when other
+ *   SRAM2 sections change size.
+ * - KERNEL_THREAD_STACK (Kernel.h): thread stacks, not initialised.
+ *
+ * @code
+ * RAM2_BSS static USART::CircularBuffer<2048> traceBuffer;
+ * RAM2_NOINIT static BootRecord bootRecord;      // Checked with its magic number
+ * @endcode
+ *
+ * @note The DMA controllers reach SRAM2 only through its 0x2000C000 alias, so
+ *       buffers handed to DMA (e.g. a UsartDriver's TX ring) must stay in main RAM.
+ */
+
+#ifndef INC_MEMORY_SECTIONS_H_
+#define INC_MEMORY_SECTIONS_H_
+
+#include "main.h"
+
+/**
+ * @brief Zero-initialised object in SRAM2
+ */
+#define RAM2_BSS __attribute__((section(".ram2_bss")))
+
+/**
+ * @brief Object in SRAM2 that start-up leaves untouched (kept over reset and Standby)
+ */
+#define RAM2_NOINIT __attribute__((section(".ram2_noinit")))
+
+namespace MEMORY
+{
+    /**
+     * @brief Keep SRAM2 powered in Standby
+     * @note Needs the PWR clock (enabled by the CubeMX start-up code)
+     */
+    inline void enableStandbyRetention() {
+        LL_PWR_EnableSRAM2Retention();
+    }
+
+} // namespace MEMORY
+
+#endif /* INC_MEMORY_SECTIONS_H_ */
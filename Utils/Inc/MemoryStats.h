@@ -0,0 +1,85 @@
+/**
+ * @file    MemoryStats.h
+ * @brief   Dynamic memory telemetry for RAM budgeting
+ *
+ * The operator new/delete overrides report every allocation here. Live and
+ * peak bytes count the memory actually reserved: the pool block, or the
+ * arena slice rounded to 8 bytes. Init-arena objects are never freed, so they
+ * stay live. The size histogram counts the requested sizes in power-of-two
+ * classes: bin n holds sizes from 2^(n-1)+1 to 2^n bytes, and the last bin
+ * holds everything larger.
+ *
+ * The newlib heap used by malloc is reported through its _sbrk break
+ * (sysmem.c). largestFreeBlock is the largest request operator new can still
+ * serve without failing.
+ *
+ * getStats() can be called from any context. printStats() writes the report
+ * with LOG_MSG.
+ */
+
+#ifndef INC_MEMORY_STATS_H_
+#define INC_MEMORY_STATS_H_
+
+#include "main.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef MEMORY_HISTOGRAM_BINS
+#define MEMORY_HISTOGRAM_BINS 10U       // 1, 2, 4 ... 256 bytes and larger
+#endif
+
+namespace MEMORY
+{
+    /**
+     * @struct Stats
+     * @brief Snapshot of the dynamic memory figures
+     */
+    struct Stats
+    {
+        uint32_t liveBytes;             ///< Reserved by live allocations
+        uint32_t peakBytes;             ///< Highest liveBytes since reset
+        uint32_t allocations;           ///< Successful operator new calls
+        uint32_t releases;              ///< operator delete calls with a non-null pointer
+        uint32_t failures;              ///< operator new calls no pool could serve
+        uint32_t histogram[MEMORY_HISTOGRAM_BINS];  ///< Allocations by requested size
+        uint32_t largestFreeBlock;      ///< Largest request operator new can serve now
+        uintptr_t sbrkStart;            ///< Start of the newlib heap (_end)
+        uintptr_t sbrkBreak;            ///< Current _sbrk break
+        uintptr_t sbrkLimit;            ///< Bottom of the reserved MSP stack
+        uint32_t sbrkFailures;          ///< _sbrk requests refused with ENOMEM
+    };
+
+    /**
+     * @brief Record a successful allocation (operator new)
+     */
+    void recordAllocation(size_t requested, const void* block);
+
+    /**
+     * @brief Record a failed allocation (operator new)
+     */
+    void recordFailure(size_t requested);
+
+    /**
+     * @brief Record a release, before the block goes back to its pool (operator delete)
+     */
+    void recordRelease(const void* block);
+
+    /**
+     * @brief Take a consistent snapshot
+     */
+    Stats getStats();
+
+    /**
+     * @brief Restart the peak and the counters; live bytes are kept
+     */
+    void resetStats();
+
+    /**
+     * @brief Write the figures, the pools and the non-empty histogram bins to the log
+     */
+    void printStats();
+
+} // namespace MEMORY
+
+#endif /* INC_MEMORY_STATS_H_ */
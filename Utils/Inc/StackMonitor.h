@@ -0,0 +1,98 @@
+/**
+ * @file    StackMonitor.h
+ * @brief   Stack painting and high-water measurement
+ *
+ * Unused stack holds a known pattern: the reset handler paints the MSP
+ * reserve (_Min_Stack_Size below _estack) before the C runtime starts, and
+ * every KERNEL::Thread paints its stack when it is constructed. Stacks grow
+ * down, so scanning up from the lowest address for the first overwritten word
+ * gives the deepest use since reset. The scan costs one read per unused
+ * word and nothing at run time before that.
+ *
+ * With STACK_SAMPLE_ISR set to 1, the interrupt bridges also record the lowest
+ * MSP seen on interrupt entry. That shows how deep interrupts nest; the
+ * painted high-water mark includes the callbacks themselves.
+ *
+ * @note A result of 100 % means the pattern is gone: the stack may have overflowed.
+ */
+
+#ifndef INC_STACK_MONITOR_H_
+#define INC_STACK_MONITOR_H_
+
+#include "main.h"
+
+#include <cstdint>
+
+#ifndef STACK_PAINT_PATTERN
+#define STACK_PAINT_PATTERN 0xA5A5A5A5UL    // Must match PaintStack in startup_stm32l433rbtx.s
+#endif
+
+#ifndef STACK_SAMPLE_ISR
+#define STACK_SAMPLE_ISR 0                  // 1: sampleMsp() records the MSP on interrupt entry
+#endif
+
+/**
+ * @namespace STACK
+ * @brief Stack usage measurement
+ */
+namespace STACK
+{
+    /**
+     * @struct Usage
+     * @brief Size and deepest use of one stack
+     */
+    struct Usage
+    {
+        uint32_t sizeBytes;     ///< Whole stack
+        uint32_t peakBytes;     ///< Deepest use since painting
+    };
+
+    /**
+     * @brief Fill a stack with the paint pattern (before it is used)
+     */
+    void paint(uint32_t* base, uint32_t words);
+
+    /**
+     * @brief Measure a painted stack
+     * @param base Lowest address of the stack
+     * @param words Stack size in words
+     */
+    Usage measure(const uint32_t* base, uint32_t words);
+
+    /**
+     * @brief Measure the MSP reserve painted by the reset handler
+     */
+    Usage measureMsp();
+
+    /**
+     * @brief Deepest MSP use seen by sampleMsp(), in bytes below _estack
+     */
+    uint32_t getSampledMspPeak();
+
+    extern volatile uint32_t lowestMsp;
+
+    /**
+     * @brief Record the current MSP if it is the lowest so far (call on interrupt entry)
+     */
+    inline void sampleMsp() {
+#if (STACK_SAMPLE_ISR == 1)
+        const uint32_t sp = __get_MSP();
+        uint32_t lowest;
+        do {
+            lowest = __LDREXW(&lowestMsp);
+            if (sp >= lowest) {
+                __CLREX();
+                return;
+            }
+        } while (__STREXW(sp, &lowestMsp) != 0);
+#endif
+    }
+
+    /**
+     * @brief Log the MSP and every thread stack
+     */
+    void printUsage();
+
+} // namespace STACK
+
+#endif /* INC_STACK_MONITOR_H_ */
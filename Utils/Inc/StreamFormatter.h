@@ -0,0 +1,1298 @@
+/**
+ * @file    StreamFormatter.h
+ * @brief   Allocation-free printf-style formatter writing straight into a ring buffer
+ *
+ * The formatter asks its sink for the largest free contiguous region, renders
+ * characters directly into it and publishes the region once it is full or the
+ * output is finished. No heap, no intermediate line buffer and no newlib printf.
+ *
+ * A sink provides the producer half of USART::CircularBuffer:
+ * @code
+ *   uint16_t reserveContiguous(uint8_t*& data); // free bytes at data without wrapping
+ *   void publish(uint16_t count);               // make count bytes visible
+ * @endcode
+ *
+ * Supported conversions: %d %i %u %x %X %o %c %s %p %f %F %e %E %g %G %% with
+ * the flags '-', '0', '+', ' ', '#', width and precision (also as '*') and the
+ * length modifiers hh, h, l, ll, z, j, t. Unknown conversions are echoed as
+ * written. Output that does not fit into the sink is dropped and reported by
+ * isTruncated().
+ *
+ * Floating-point limits, in exchange for staying out of libm and newlib:
+ * - Digits are derived with double arithmetic. Up to 10 significant digits
+ *   match printf (rounded to nearest, ties to even). With more digits, values
+ *   outside about 1e-19..1e19, which are scaled by powers of ten first, may
+ *   differ in the last place.
+ * - Fraction digits past the 19th are printed as '0'.
+ * - %f of a value of 2^64 or more is printed in %e notation.
+ */
+
+#ifndef INC_STREAM_FORMATTER_H_
+#define INC_STREAM_FORMATTER_H_
+
+#include <cfloat>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @namespace FORMAT
+ * @brief Text formatting helpers that do not depend on newlib stdio
+ */
+namespace FORMAT
+{
+    /**
+     * @brief Streaming formatter rendering into the free regions of a sink
+     * @tparam Sink Type providing reserveContiguous()/publish()
+     */
+    template<typename Sink>
+    class StreamFormatter {
+    private:
+        /**
+         * @brief Parsed conversion specification
+         */
+        struct Spec {
+            bool leftAlign = false;
+            bool zeroPad = false;
+            bool plusSign = false;
+            bool spaceSign = false;
+            bool alternate = false;
+            uint16_t width = 0;
+            int16_t precision = -1;     // -1: not given
+        };
+
+        static constexpr uint32_t POW10[10] = {
+            1U, 10U, 100U, 1000U, 10000U, 100000U,
+            1000000U, 10000000U, 100000000U, 1000000000U
+        };
+
+        static constexpr uint8_t MAX_DECIMALS = 19;         // Fraction digits held in a uint64_t
+        static constexpr double FIXED_LIMIT = 1.8e19;       // %f integer parts below 2^64
+
+        static constexpr double POW10_DOUBLE[MAX_DECIMALS + 1] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+            1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19
+        };
+
+        // 10^(256 >> i), for normalize()
+        static constexpr double POW10_BINARY[9] = {
+            1e256, 1e128, 1e64, 1e32, 1e16, 1e8, 1e4, 1e2, 1e1
+        };
+
+        static constexpr char DIGIT_PAIRS[201] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        // Digit words are stored with one memcpy, first digit in the lowest byte
+        static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Digit words need a little-endian target");
+
+        Sink& sink;
+        uint8_t* region = nullptr;  // Start of the current free region of the sink
+        uint8_t* cursor = nullptr;  // Next byte to write in the region
+        uint8_t* limit = nullptr;   // End of the region
+        uint16_t published = 0;     // Bytes published from earlier regions
+        bool truncated = false;
+
+        uint16_t written() const {
+            return static_cast<uint16_t>(published + (cursor - region));
+        }
+
+        /**
+         * @brief Publish the current region and reserve the next one
+         * @return false if the sink is full
+         */
+        bool nextRegion() {
+            if (truncated) {
+                return false;
+            }
+            const uint16_t used = static_cast<uint16_t>(cursor - region);
+            if (used > 0) {
+                sink.publish(used);
+                published = static_cast<uint16_t>(published + used);
+            }
+            const uint16_t space = sink.reserveContiguous(region);
+            cursor = region;
+            limit = region + space;
+            if (space == 0) {
+                truncated = true;
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Whether a format character is copied as is
+         */
+        static bool isLiteral(char c) {
+            return c != '\0' && c != '%';
+        }
+
+        static uint8_t countDecimalDigits(uint32_t value) {
+            // Digits from the bit length: each entry adds 2^32 - 10^k for the bit lengths that can
+            // reach 10^k, so the carry into the upper half counts one more digit (Lemire)
+            static constexpr uint64_t TABLE[32] = {
+                4294967296ULL, 4294967296ULL, 4294967296ULL, 8589934582ULL,
+                8589934592ULL, 8589934592ULL, 12884901788ULL, 12884901888ULL,
+                12884901888ULL, 17179868184ULL, 17179869184ULL, 17179869184ULL,
+                17179869184ULL, 21474826480ULL, 21474836480ULL, 21474836480ULL,
+                25769703776ULL, 25769803776ULL, 25769803776ULL, 30063771072ULL,
+                30064771072ULL, 30064771072ULL, 30064771072ULL, 34349738368ULL,
+                34359738368ULL, 34359738368ULL, 38554705664ULL, 38654705664ULL,
+                38654705664ULL, 41949672960ULL, 42949672960ULL, 42949672960ULL
+            };
+            return static_cast<uint8_t>((value + TABLE[31U - static_cast<uint32_t>(__builtin_clz(value | 1U))]) >> 32);
+        }
+
+        static uint8_t countDigits(uint32_t value, uint8_t base) {
+            if (base == 10) {
+                return countDecimalDigits(value);
+            }
+            const uint32_t bits = 32U - static_cast<uint32_t>(__builtin_clz(value | 1U));
+            return static_cast<uint8_t>((base == 16) ? ((bits + 3U) >> 2) : ((bits + 2U) / 3U));
+        }
+
+        /**
+         * @brief Render exactly digits characters of value backwards, ending just before end
+         */
+        static void renderDigits(uint8_t* end, uint32_t value, uint8_t digits, uint8_t base, bool uppercase) {
+            uint8_t* const start = end - digits;
+            uint8_t* out = end;
+            // Division by a constant is a multiply
+            if (base == 10) {
+                // Two digits per division
+                while (out - start >= 2) {
+                    const char* pair = &DIGIT_PAIRS[(value % 100U) * 2U];
+                    value /= 100U;
+                    *--out = static_cast<uint8_t>(pair[1]);
+                    *--out = static_cast<uint8_t>(pair[0]);
+                }
+                if (out != start) {
+                    *--out = static_cast<uint8_t>('0' + (value % 10U));
+                }
+            } else {
+                const char* symbols = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+                const uint8_t shift = (base == 16) ? 4 : 3;
+                const uint32_t mask = base - 1U;
+                while (out != start) {
+                    *--out = static_cast<uint8_t>(symbols[value & mask]);
+                    value >>= shift;
+                }
+            }
+        }
+
+        /**
+         * @brief Emit exactly digits characters of value (leading zeros included)
+         */
+        void putDigits(uint32_t value, uint8_t digits, uint8_t base, bool uppercase) {
+            const char* symbols = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+
+            if (cursor == limit) {
+                nextRegion();
+            }
+
+            // Fast path: the whole number fits the region
+            if (limit - cursor >= digits) {
+                cursor += digits;
+                renderDigits(cursor, value, digits, base, uppercase);
+                return;
+            }
+
+            // Slow path across a region boundary: most significant digit first
+            for (int8_t i = static_cast<int8_t>(digits - 1); i >= 0; i--) {
+                uint32_t digit;
+                if (base == 10) {
+                    digit = (i < 10) ? (value / POW10[i]) % 10U : 0U;
+                } else {
+                    const uint8_t bitPos = static_cast<uint8_t>(i * ((base == 16) ? 4 : 3));
+                    digit = (bitPos < 32) ? ((value >> bitPos) & (base - 1U)) : 0U;
+                }
+                putChar(symbols[digit]);
+            }
+        }
+
+        /**
+         * @brief Eight decimal digits of value (< 10^8) as ASCII, first digit in the lowest byte
+         * @details Splits into 4+4, 2+2+2+2 and 1+...+1 digit lanes of one 64-bit word;
+         *          each division by a constant is a multiply and shift on all lanes at once.
+         */
+        static uint64_t decimalWord(uint32_t value) {
+            // Each step moves the lanes up and subtracts quotient * (divisor << shift) - 1 in one multiply,
+            // leaving the remainder in the upper and the quotient in the lower half of every lane
+            const uint64_t high = value / 10000U;
+            const uint64_t x = (static_cast<uint64_t>(value) << 32) - high * 0x0000270FFFFFFFFFULL;
+            const uint64_t hundreds = ((x * 10486U) >> 20) & 0x0000007F0000007FULL;     // x / 100 per lane
+            const uint64_t y = (x << 16) - hundreds * 0x0063FFFFU;
+            const uint64_t tens = ((y * 103U) >> 10) & 0x000F000F000F000FULL;           // y / 10 per lane
+            return ((y << 8) - tens * 0x09FFU) + 0x3030303030303030ULL;
+        }
+
+        /**
+         * @brief Eight hexadecimal digits of value as ASCII, first digit in the lowest byte
+         */
+        static uint64_t hexWord(uint32_t value, bool uppercase) {
+            // Spread the nibbles to one per byte, most significant first
+            uint64_t x = value;
+            x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+            x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+            x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            x = __builtin_bswap64(x);
+            // Bytes of 10..15 carry into bit 4 when 6 is added
+            const uint64_t letters = ((x + 0x0606060606060606ULL) >> 4) & 0x0101010101010101ULL;
+            return x + 0x3030303030303030ULL + letters * (uppercase ? 7U : 39U);
+        }
+
+        /**
+         * @brief Write the last count characters of a digit word (count <= 8)
+         * @note Stores 8 bytes: out needs 8 bytes of room
+         */
+        static uint8_t* storeWord(uint8_t* out, uint64_t word, uint8_t count) {
+            word >>= 8U * (8U - count);
+            memcpy(out, &word, sizeof(word));
+            return out + count;
+        }
+
+        /**
+         * @brief Write exactly digits decimal digits of value (leading zeros included)
+         * @note Stores 8 bytes past the last digit written: out needs digits + 8 bytes of room
+         */
+        static uint8_t* storeDecimal(uint8_t* out, uint32_t value, uint8_t digits) {
+            if (digits > 8) {
+                const uint32_t lead = value / 100000000U;
+                value -= lead * 100000000U;
+                if (digits > 9) {
+                    *out++ = static_cast<uint8_t>(DIGIT_PAIRS[lead * 2U]);
+                }
+                *out++ = static_cast<uint8_t>(DIGIT_PAIRS[lead * 2U + 1U]);
+                digits = 8;
+            }
+            return storeWord(out, decimalWord(value), digits);
+        }
+
+        /**
+         * @brief Emit a 32-bit decimal or hexadecimal field with width and '-' or '0' in one pass
+         * @param decimals Fraction digits following a decimal point (%f), 0 for none
+         * @param fraction Value of the fraction digits, below 10^decimals
+         * @return false (nothing written) if the field does not fit the current region or needs
+         *         more than 8 padding characters
+         * @note Pads and stores digits 8 bytes at a time, so the field must leave 8 bytes of room behind it
+         */
+        __attribute__((always_inline))
+        bool putIntegerField(uint32_t value, bool negative, uint32_t width, bool leftAlign, bool zeroPad,
+                             uint8_t base, bool uppercase, uint8_t decimals = 0, uint32_t fraction = 0) {
+            const uint8_t digits = countDigits(value, base);
+            const uint32_t length = digits + (negative ? 1U : 0U) + ((decimals > 0) ? decimals + 1U : 0U);
+            const uint32_t padding = (width > length) ? (width - length) : 0U;
+            if (base == 8 || padding > 8 || static_cast<uint32_t>(limit - cursor) < length + padding + 8U) {
+                return false;
+            }
+
+            uint8_t* out = cursor;
+            // The field ends at its width whenever it is padded: the next field need not wait for the digits
+            uint8_t* const fieldEnd = out + ((padding > 0) ? width : length);
+            if (!leftAlign && !zeroPad) {
+                memcpy(out, "        ", 8);
+                out += padding;
+            }
+            if (negative) {
+                *out++ = '-';
+            }
+            if (zeroPad) {
+                memcpy(out, "00000000", 8);
+                out += padding;
+            }
+            if (base == 16) {
+                out = storeWord(out, hexWord(value, uppercase), digits);
+            } else {
+                out = storeDecimal(out, value, digits);
+            }
+            if (decimals > 0) {
+                *out++ = '.';
+                out = storeWord(out, decimalWord(fraction), decimals);
+            }
+            if (leftAlign) {
+                memcpy(out, "        ", 8);
+            }
+            cursor = fieldEnd;
+            return true;
+        }
+
+        /**
+         * @brief Emit a %f field with at most 8 decimals and an integer part below 2^32 in one pass
+         * @return false (nothing written) if the value or the field does not fit
+         */
+        bool putFixedField(double value, uint8_t decimals, uint32_t width, bool leftAlign, bool zeroPad) {
+            const bool negative = (value < 0.0);
+            if (negative) {
+                value = -value;
+            }
+            if (!(value < 4294967296.0)) {
+                return false;       // Also NaN
+            }
+            uint64_t integer;
+            uint64_t fraction;
+            splitDouble(value, decimals, integer, fraction);
+            return (integer <= 0xFFFFFFFFULL) &&
+                   putIntegerField(static_cast<uint32_t>(integer), negative, width, leftAlign, zeroPad, 10, false,
+                                   decimals, static_cast<uint32_t>(fraction));
+        }
+
+        /**
+         * @brief Emit an integer field with sign, prefix, precision and width
+         */
+        void putInteger(uint64_t magnitude, bool negative, const Spec& spec, uint8_t base, bool uppercase) {
+            // Split into 32-bit chunks so the common case never touches 64-bit division
+            uint32_t chunks[3] = { static_cast<uint32_t>(magnitude), 0U, 0U };
+            uint8_t chunkCount = 1;
+            uint8_t chunkDigits = 0;    // Digits per lower chunk
+            if (magnitude > 0xFFFFFFFFULL) {
+                if (base == 10) {
+                    chunkDigits = 9;
+                    chunks[0] = static_cast<uint32_t>(magnitude % 1000000000ULL);
+                    magnitude /= 1000000000ULL;
+                    chunks[1] = static_cast<uint32_t>(magnitude % 1000000000ULL);
+                    chunks[2] = static_cast<uint32_t>(magnitude / 1000000000ULL);
+                    chunkCount = (chunks[2] != 0U) ? 3 : 2;
+                } else {
+                    // 30 bits per chunk: a whole number of hex (4) and octal (3) digits
+                    chunkDigits = (base == 16) ? 7 : 10;
+                    const uint8_t bits = (base == 16) ? 28 : 30;
+                    const uint32_t mask = (1UL << bits) - 1U;
+                    chunks[0] = static_cast<uint32_t>(magnitude & mask);
+                    chunks[1] = static_cast<uint32_t>((magnitude >> bits) & mask);
+                    chunks[2] = static_cast<uint32_t>(magnitude >> (2 * bits));
+                    chunkCount = (chunks[2] != 0U) ? 3 : 2;
+                }
+            }
+
+            uint8_t leadDigits = countDigits(chunks[chunkCount - 1], base);
+            uint16_t digits = static_cast<uint16_t>(leadDigits + (chunkCount - 1) * chunkDigits);
+            if (spec.precision == 0 && magnitude == 0) {
+                digits = 0;   // printf: "%.0d" of 0 prints nothing
+            }
+
+            char sign = 0;
+            if (negative) {
+                sign = '-';
+            } else if (spec.plusSign && base == 10) {
+                sign = '+';
+            } else if (spec.spaceSign && base == 10) {
+                sign = ' ';
+            }
+
+            const char* prefix = "";
+            uint16_t prefixLength = 0;
+            if (spec.alternate && magnitude != 0) {
+                if (base == 16) {
+                    prefix = uppercase ? "0X" : "0x";
+                    prefixLength = 2;
+                } else if (base == 8) {
+                    prefix = "0";
+                    prefixLength = 1;
+                }
+            }
+
+            uint16_t zeros = 0;
+            if (spec.precision > 0 && static_cast<uint16_t>(spec.precision) > digits) {
+                zeros = static_cast<uint16_t>(spec.precision - digits);
+            }
+
+            uint16_t length = static_cast<uint16_t>((sign ? 1 : 0) + prefixLength + zeros + digits);
+            uint16_t padding = (spec.width > length) ? static_cast<uint16_t>(spec.width - length) : 0;
+
+            if (spec.zeroPad && !spec.leftAlign && spec.precision < 0) {
+                zeros = static_cast<uint16_t>(zeros + padding);
+                padding = 0;
+            }
+
+            if (!spec.leftAlign && padding > 0) {
+                putRepeated(' ', padding);
+            }
+            if (sign) {
+                putChar(sign);
+            }
+            if (prefixLength > 0) {
+                putChars(prefix, prefixLength);
+            }
+            if (zeros > 0) {
+                putRepeated('0', zeros);
+            }
+            if (digits > 0) {
+                putDigits(chunks[chunkCount - 1], leadDigits, base, uppercase);
+                for (int8_t i = static_cast<int8_t>(chunkCount - 2); i >= 0; i--) {
+                    putDigits(chunks[i], chunkDigits, base, uppercase);
+                }
+            }
+            if (spec.leftAlign) {
+                putRepeated(' ', padding);
+            }
+        }
+
+        /**
+         * @brief Scale a positive finite value into [1, 10)
+         * @return Decimal exponent of the value
+         */
+        static int16_t normalize(double& value) {
+            // Binary search over the exponent: at most 9 multiplications or divisions
+            int16_t exponent = 0;
+            if (value >= 10.0) {
+                for (uint8_t i = 0; i < 9; i++) {
+                    if (value >= POW10_BINARY[i]) {
+                        value /= POW10_BINARY[i];
+                        exponent = static_cast<int16_t>(exponent + (256 >> i));
+                    }
+                }
+            } else if (value < 1.0) {
+                for (uint8_t i = 0; i < 9; i++) {
+                    if (value * POW10_BINARY[i] < 10.0) {
+                        value *= POW10_BINARY[i];
+                        exponent = static_cast<int16_t>(exponent - (256 >> i));
+                    }
+                }
+            }
+            // Rounding in the steps above can leave the value just outside the range
+            if (value >= 10.0) {
+                value /= 10.0;
+                exponent++;
+            } else if (value < 1.0) {
+                value *= 10.0;
+                exponent--;
+            }
+            return exponent;
+        }
+
+        /**
+         * @brief Rounding error of a product, product = a * b rounded (Dekker, no FMA needed)
+         */
+        static double productError(double a, double b, double product) {
+            constexpr double SPLIT = 134217729.0;  // 2^27 + 1
+            const double aBig = a * SPLIT;
+            const double aHigh = aBig - (aBig - a);
+            const double aLow = a - aHigh;
+            const double bBig = b * SPLIT;
+            const double bHigh = bBig - (bBig - b);
+            const double bLow = b - bHigh;
+            return ((aHigh * bHigh - product) + aHigh * bLow + aLow * bHigh) + aLow * bLow;
+        }
+
+        /**
+         * @brief Round a non-negative value (below 2^64) at decimals and split it
+         * @param decimals Fraction digits, at most MAX_DECIMALS
+         */
+        static void splitDouble(double value, uint8_t decimals, uint64_t& integer, uint64_t& fraction) {
+            const uint64_t scale = static_cast<uint64_t>(POW10_DOUBLE[decimals]);
+            integer = static_cast<uint64_t>(value);
+            // The integer part is removed exactly, so only the scaling rounds
+            const double part = value - static_cast<double>(integer);
+            const double scaled = part * POW10_DOUBLE[decimals];
+            fraction = static_cast<uint64_t>(scaled);
+            const double rest = scaled - static_cast<double>(fraction);
+            bool roundUp = (rest > 0.5);
+            if (rest == 0.5) {
+                // Possibly a tie created by the scaling: decide on the exact product
+                const double error = productError(part, POW10_DOUBLE[decimals], scaled);
+                const uint64_t last = (decimals > 0) ? fraction : integer;
+                roundUp = (error > 0.0) || (error == 0.0 && (last & 1U));   // Ties to even, as printf
+            }
+            if (roundUp) {
+                fraction++;
+            }
+            if (fraction >= scale) {
+                fraction -= scale;
+                integer++;
+            }
+        }
+
+        /**
+         * @brief Round a positive finite value to 1 + decimals significant digits
+         * @param decimals Fraction digits of the mantissa, at most MAX_DECIMALS
+         * @param integer Leading digit (1..9)
+         * @param fraction Following decimals digits
+         * @return Decimal exponent
+         */
+        static int16_t splitExponential(double value, uint8_t decimals, uint64_t& integer, uint64_t& fraction) {
+            double mantissa = value;
+            int16_t exponent = normalize(mantissa);
+
+            // Round at the same digit of the unscaled value when that fits 64 bits:
+            // one rounding instead of the scaling steps of normalize()
+            const int16_t shift = static_cast<int16_t>(decimals - exponent);
+            if (value < FIXED_LIMIT && decimals < MAX_DECIMALS && shift >= -MAX_DECIMALS && shift <= MAX_DECIMALS) {
+                uint64_t significand;
+                if (shift >= 0) {
+                    uint64_t whole;
+                    uint64_t part;
+                    splitDouble(value, static_cast<uint8_t>(shift), whole, part);
+                    significand = whole * static_cast<uint64_t>(POW10_DOUBLE[shift]) + part;
+                } else {
+                    // Rounding inside the integer part: exact in integers
+                    const uint64_t whole = static_cast<uint64_t>(value);
+                    const uint64_t divisor = static_cast<uint64_t>(POW10_DOUBLE[-shift]);
+                    const uint64_t rest = whole % divisor;
+                    const uint64_t half = divisor / 2U;
+                    significand = whole / divisor;
+                    const bool above = (static_cast<double>(whole) != value);   // Nonzero fraction
+                    if (rest > half || (rest == half && (above || (significand & 1U)))) {
+                        significand++;
+                    }
+                }
+                const uint64_t top = static_cast<uint64_t>(POW10_DOUBLE[decimals]);
+                if (significand == top * 10U) {
+                    // Rounded up to the next power of ten
+                    integer = 1;
+                    fraction = 0;
+                    return static_cast<int16_t>(exponent + 1);
+                }
+                if (significand >= top && significand < top * 10U) {
+                    integer = significand / top;
+                    fraction = significand % top;
+                    return exponent;
+                }
+                // Otherwise the estimate from normalize() was off by one: use the scaled value
+            }
+
+            splitDouble(mantissa, decimals, integer, fraction);
+            if (integer >= 10U) {
+                // Rounded up to 10.000...: the fraction is already zero
+                integer = 1;
+                exponent++;
+            }
+            return exponent;
+        }
+
+        /**
+         * @brief Drop trailing zeros of a fraction (%g without '#')
+         */
+        static void trimZeros(uint64_t& fraction, uint16_t& decimals) {
+            while (decimals > 0 && (fraction % 10U) == 0) {
+                fraction /= 10U;
+                decimals--;
+            }
+        }
+
+        /**
+         * @brief Emit a double in fixed-point notation (%f)
+         * @param value Non-negative value below 2^64
+         * @param trim Drop trailing zeros of the fraction
+         */
+        void putFixedDouble(double value, uint16_t decimals, bool negative, const Spec& spec, bool trim) {
+            const uint8_t digits = (decimals > MAX_DECIMALS) ? MAX_DECIMALS : static_cast<uint8_t>(decimals);
+            uint64_t integer;
+            uint64_t fraction;
+            splitDouble(value, digits, integer, fraction);
+            if (trim) {
+                decimals = digits;
+                trimZeros(fraction, decimals);
+            }
+            putFixedParts(integer, fraction, decimals, negative, spec);
+        }
+
+        /**
+         * @brief Emit a double in exponent notation (%e)
+         * @param value Non-negative finite value
+         * @param trim Drop trailing zeros of the fraction
+         */
+        void putExponential(double value, uint16_t decimals, bool negative, const Spec& spec, bool uppercase, bool trim) {
+            const uint8_t digits = (decimals > MAX_DECIMALS) ? MAX_DECIMALS : static_cast<uint8_t>(decimals);
+            uint64_t integer = 0;
+            uint64_t fraction = 0;
+            const int16_t exponent = (value != 0.0) ? splitExponential(value, digits, integer, fraction) : 0;
+            if (trim) {
+                decimals = digits;
+                trimZeros(fraction, decimals);
+            }
+
+            // "e+dd", three exponent digits only when needed
+            char suffix[5];
+            uint8_t suffixLength = 0;
+            const uint16_t magnitude = static_cast<uint16_t>((exponent < 0) ? -exponent : exponent);
+            suffix[suffixLength++] = uppercase ? 'E' : 'e';
+            suffix[suffixLength++] = (exponent < 0) ? '-' : '+';
+            if (magnitude >= 100U) {
+                suffix[suffixLength++] = static_cast<char>('0' + magnitude / 100U);
+            }
+            suffix[suffixLength++] = static_cast<char>('0' + (magnitude / 10U) % 10U);
+            suffix[suffixLength++] = static_cast<char>('0' + magnitude % 10U);
+
+            putFixedParts(integer, fraction, decimals, negative, spec, suffix, suffixLength);
+        }
+
+        /**
+         * @brief Emit a double (%f, %e, %g and their uppercase forms)
+         */
+        void putDouble(double value, const Spec& spec, char conversion) {
+            const bool uppercase = (conversion >= 'A' && conversion <= 'Z');
+            const char style = static_cast<char>(conversion | 0x20);
+            uint16_t precision = (spec.precision < 0) ? 6 : static_cast<uint16_t>(spec.precision);
+
+            const bool negative = (value < 0.0);
+            if (negative) {
+                value = -value;
+            }
+
+            if (value != value || value > DBL_MAX) {
+                Spec text;
+                text.width = spec.width;
+                text.leftAlign = spec.leftAlign;
+                if (value != value) {
+                    putStringField(uppercase ? "NAN" : "nan", text);
+                } else if (negative) {
+                    putStringField(uppercase ? "-INF" : "-inf", text);
+                } else {
+                    putStringField(uppercase ? "INF" : "inf", text);
+                }
+                return;
+            }
+
+            if (style == 'g') {
+                if (precision == 0) {
+                    precision = 1;
+                }
+                // The exponent after rounding to precision significant digits picks the style
+                int16_t exponent = 0;
+                if (value != 0.0) {
+                    const uint8_t digits = (precision - 1U > MAX_DECIMALS) ? MAX_DECIMALS : static_cast<uint8_t>(precision - 1U);
+                    uint64_t integer;
+                    uint64_t fraction;
+                    exponent = splitExponential(value, digits, integer, fraction);
+                }
+                if (exponent >= -4 && exponent < static_cast<int16_t>(precision) && value < FIXED_LIMIT) {
+                    putFixedDouble(value, static_cast<uint16_t>(precision - 1 - exponent), negative, spec, !spec.alternate);
+                } else {
+                    putExponential(value, static_cast<uint16_t>(precision - 1U), negative, spec, uppercase, !spec.alternate);
+                }
+                return;
+            }
+
+            if (style == 'f' && value < FIXED_LIMIT) {
+                putFixedDouble(value, precision, negative, spec, false);
+                return;
+            }
+            // %e, or %f beyond the 64-bit integer part
+            putExponential(value, precision, negative, spec, uppercase, false);
+        }
+
+        /**
+         * @brief Emit decimals fraction digits of a MAX_DECIMALS-digit fraction
+         * @details Digits beyond MAX_DECIMALS are zeros.
+         */
+        void putFraction(uint64_t fraction, uint16_t decimals) {
+            uint16_t zeros = 0;
+            if (decimals > MAX_DECIMALS) {
+                zeros = static_cast<uint16_t>(decimals - MAX_DECIMALS);
+                decimals = MAX_DECIMALS;
+            }
+            // 32-bit chunks of at most 9 digits, most significant first
+            if (decimals > 18U) {
+                putDigits(static_cast<uint32_t>(fraction / 1000000000000000000ULL), static_cast<uint8_t>(decimals - 18U), 10, false);
+                fraction %= 1000000000000000000ULL;
+                decimals = 18;
+            }
+            if (decimals > 9U) {
+                putDigits(static_cast<uint32_t>(fraction / 1000000000ULL), static_cast<uint8_t>(decimals - 9U), 10, false);
+                fraction %= 1000000000ULL;
+                decimals = 9;
+            }
+            if (decimals > 0) {
+                putDigits(static_cast<uint32_t>(fraction), static_cast<uint8_t>(decimals), 10, false);
+            }
+            if (zeros > 0) {
+                putRepeated('0', zeros);
+            }
+        }
+
+        /**
+         * @brief Emit "<integer>.<fraction><suffix>" honouring sign, width and padding
+         */
+        void putFixedParts(uint64_t integer, uint64_t fraction, uint16_t decimals, bool negative, const Spec& spec,
+                           const char* suffix = "", uint8_t suffixLength = 0) {
+            Spec integerSpec = spec;
+            integerSpec.precision = -1;
+            integerSpec.alternate = false;
+            const bool point = (decimals > 0) || spec.alternate;     // '#': always a decimal point
+            const uint16_t tailLength = static_cast<uint16_t>((point ? 1U : 0U) + decimals + suffixLength);
+            integerSpec.width = (spec.width > tailLength) ? static_cast<uint16_t>(spec.width - tailLength) : 0;
+
+            if (spec.leftAlign) {
+                integerSpec.width = 0;      // Padding belongs after the fraction
+            }
+
+            const uint16_t start = written();
+            // Plain decimal integer parts take the one-pass path
+            if (integer > 0xFFFFFFFFULL || spec.plusSign || spec.spaceSign ||
+                !putIntegerField(static_cast<uint32_t>(integer), negative, integerSpec.width, false, spec.zeroPad, 10, false)) {
+                putInteger(integer, negative, integerSpec, 10, false);
+            }
+            if (point) {
+                putChar('.');
+                putFraction(fraction, decimals);
+            }
+            putChars(suffix, suffixLength);
+
+            if (spec.leftAlign) {
+                const uint16_t length = static_cast<uint16_t>(written() - start);
+                if (spec.width > length) {
+                    putRepeated(' ', static_cast<uint16_t>(spec.width - length));
+                }
+            }
+        }
+
+        /**
+         * @brief Write a string field (%s semantics: precision limits, width pads)
+         */
+        void putStringField(const char* str, const Spec& spec) {
+            if (spec.width == 0 && spec.precision < 0) {
+                putString(str);
+                return;
+            }
+            if (str == nullptr) {
+                str = "(null)";
+            }
+            size_t length = 0;
+            const size_t maxLength = (spec.precision < 0) ? SIZE_MAX : static_cast<size_t>(spec.precision);
+            while (length < maxLength && str[length] != '\0') {
+                length++;
+            }
+
+            const uint16_t padding = (spec.width > length) ? static_cast<uint16_t>(spec.width - length) : 0;
+            if (!spec.leftAlign) {
+                putRepeated(' ', padding);
+            }
+            putChars(str, length);
+            if (spec.leftAlign) {
+                putRepeated(' ', padding);
+            }
+        }
+
+    public:
+        /**
+         * @brief Construct a formatter on a sink
+         * @param target Sink receiving the output (e.g. a TX CircularBuffer)
+         */
+        explicit StreamFormatter(Sink& target) : sink(target) {}
+
+        StreamFormatter(const StreamFormatter&) = delete;
+        StreamFormatter& operator=(const StreamFormatter&) = delete;
+
+        /**
+         * @brief Write one character
+         */
+        void putChar(char c) {
+            if (cursor == limit && !nextRegion()) {
+                return;
+            }
+            *cursor++ = static_cast<uint8_t>(c);
+        }
+
+        /**
+         * @brief Write length characters, copying region by region
+         */
+        void putChars(const char* data, size_t length) {
+            while (length > 0) {
+                if (cursor == limit && !nextRegion()) {
+                    return;
+                }
+                size_t chunk = static_cast<size_t>(limit - cursor);
+                if (chunk > length) {
+                    chunk = length;
+                }
+                memcpy(cursor, data, chunk);
+                cursor += chunk;
+                data += chunk;
+                length -= chunk;
+            }
+        }
+
+        /**
+         * @brief Write count copies of c (padding)
+         */
+        void putRepeated(char c, uint16_t count) {
+            while (count > 0) {
+                if (cursor == limit && !nextRegion()) {
+                    return;
+                }
+                uint16_t chunk = static_cast<uint16_t>(limit - cursor);
+                if (chunk > count) {
+                    chunk = count;
+                }
+                uint8_t* out = cursor;
+                cursor += chunk;
+                while (out != cursor) {
+                    *out++ = static_cast<uint8_t>(c);   // Padding is short; a loop beats a memset call
+                }
+                count = static_cast<uint16_t>(count - chunk);
+            }
+        }
+
+        /**
+         * @brief Write a null-terminated string
+         */
+        void putString(const char* str) {
+            if (str == nullptr) {
+                str = "(null)";
+            }
+            // Scan and copy in a single pass
+            uint8_t* out = cursor;
+            uint8_t* end = limit;
+            // Four bytes per bound check while the region has room for them
+            while (end - out >= 4) {
+                if (str[0] == '\0') {
+                    break;
+                }
+                out[0] = static_cast<uint8_t>(str[0]);
+                if (str[1] == '\0') {
+                    out += 1;
+                    str += 1;
+                    break;
+                }
+                out[1] = static_cast<uint8_t>(str[1]);
+                if (str[2] == '\0') {
+                    out += 2;
+                    str += 2;
+                    break;
+                }
+                out[2] = static_cast<uint8_t>(str[2]);
+                if (str[3] == '\0') {
+                    out += 3;
+                    str += 3;
+                    break;
+                }
+                out[3] = static_cast<uint8_t>(str[3]);
+                out += 4;
+                str += 4;
+            }
+            while (*str != '\0') {
+                if (out == end) {
+                    cursor = out;
+                    if (!nextRegion()) {
+                        return;
+                    }
+                    out = cursor;
+                    end = limit;
+                }
+                *out++ = static_cast<uint8_t>(*str++);
+            }
+            cursor = out;
+        }
+
+        /**
+         * @brief Write an unsigned decimal number
+         */
+        void putUnsigned(uint32_t value) {
+            putDigits(value, countDecimalDigits(value), 10, false);
+        }
+
+        /**
+         * @brief Write a signed decimal number
+         */
+        void putSigned(int32_t value) {
+            const bool negative = (value < 0);
+            const uint32_t magnitude = negative ? (0U - static_cast<uint32_t>(value)) : static_cast<uint32_t>(value);
+            if (negative) {
+                putChar('-');
+            }
+            putDigits(magnitude, countDecimalDigits(magnitude), 10, false);
+        }
+
+        /**
+         * @brief Write a hexadecimal number with a fixed number of digits
+         * @param value Value to print
+         * @param digits Minimum number of digits (zero padded)
+         * @param uppercase Use uppercase hex digits
+         */
+        void putHex(uint32_t value, uint8_t digits = 8, bool uppercase = true) {
+            Spec spec;
+            spec.precision = digits;
+            putInteger(value, false, spec, 16, uppercase);
+        }
+
+        /**
+         * @brief Write a signed Q-format fixed-point number without using floating point
+         * @param raw Raw fixed-point value (e.g. Q16.16)
+         * @param fractionBits Number of fractional bits in raw (0-31)
+         * @param decimals Number of decimal places to print (0-9), rounded
+         */
+        void putFixed(int32_t raw, uint8_t fractionBits, uint8_t decimals) {
+            if (decimals > 9) {
+                decimals = 9;
+            }
+            const bool negative = (raw < 0);
+            const uint32_t magnitude = negative ? (0U - static_cast<uint32_t>(raw)) : static_cast<uint32_t>(raw);
+
+            uint32_t integer = (fractionBits < 32) ? (magnitude >> fractionBits) : 0U;
+            const uint64_t fractionRaw = (fractionBits < 32) ? (magnitude & ((1ULL << fractionBits) - 1U)) : magnitude;
+            uint64_t scaled = fractionRaw * POW10[decimals];
+            if (fractionBits > 0) {
+                scaled = (scaled + (1ULL << (fractionBits - 1))) >> fractionBits;
+            }
+            if (scaled >= POW10[decimals]) {
+                integer++;
+                scaled -= POW10[decimals];
+            }
+
+            putFixedParts(integer, static_cast<uint32_t>(scaled), decimals, negative, Spec{});
+        }
+
+        /**
+         * @brief Render a printf-style format string
+         * @param format Format string
+         * @param args Argument list
+         * @note Always inlined: each sink type has a single variadic wrapper (sendFormatted()), and
+         *       inside it the argument list is a local the compiler can keep out of memory
+         */
+        __attribute__((always_inline))
+        void vformat(const char* format, va_list args) {
+            // Reserve up front so the first run of text takes the fast path
+            if (cursor == limit && !nextRegion()) {
+                return;
+            }
+            while (*format != '\0') {
+                // Scan and copy literal text in a single pass straight into the region
+                uint8_t* out = cursor;
+                uint8_t* const end = limit;
+
+                // Four bytes per bound check while the region has room for them
+                while (end - out >= 4) {
+                    if (!isLiteral(format[0])) {
+                        break;
+                    }
+                    out[0] = static_cast<uint8_t>(format[0]);
+                    if (!isLiteral(format[1])) {
+                        out += 1;
+                        format += 1;
+                        break;
+                    }
+                    out[1] = static_cast<uint8_t>(format[1]);
+                    if (!isLiteral(format[2])) {
+                        out += 2;
+                        format += 2;
+                        break;
+                    }
+                    out[2] = static_cast<uint8_t>(format[2]);
+                    if (!isLiteral(format[3])) {
+                        out += 3;
+                        format += 3;
+                        break;
+                    }
+                    out[3] = static_cast<uint8_t>(format[3]);
+                    out += 4;
+                    format += 4;
+                }
+                char c = *format;
+                while (c != '\0' && c != '%' && out != end) {
+                    *out++ = static_cast<uint8_t>(c);
+                    c = *++format;
+                }
+                cursor = out;
+                if (c == '\0') {
+                    break;
+                }
+                if (c != '%') {
+                    if (!nextRegion()) {
+                        return;     // Sink full: the rest would be dropped anyway
+                    }
+                    continue;
+                }
+                format++;   // Skip '%'
+
+                // Bare conversions (no flags, width, precision or length) skip the parser
+                {
+                    const char bare = *format;
+                    if (bare == 's') {
+                        format++;
+                        putString(va_arg(args, const char*));
+                        continue;
+                    }
+                    if (bare == 'u') {
+                        format++;
+                        putUnsigned(va_arg(args, unsigned int));
+                        continue;
+                    }
+                    if (bare == 'd' || bare == 'i') {
+                        format++;
+                        putSigned(va_arg(args, int));
+                        continue;
+                    }
+                    if (bare == '%') {
+                        format++;
+                        putChar('%');
+                        continue;
+                    }
+                }
+
+                // Common fields, [-|0][width][l]{d,i,u,x,X} and [-|0][width].{0-8}f, skip the parser too
+                {
+                    // Text before the field may have filled the region
+                    if (cursor == limit && !nextRegion()) {
+                        return;
+                    }
+                    const char* spec = format;
+                    const bool leftAlign = (*spec == '-');
+                    const bool zeroPad = (*spec == '0');
+                    if (leftAlign || zeroPad) {
+                        spec++;
+                    }
+                    uint32_t width = 0;
+                    while (*spec >= '0' && *spec <= '9') {
+                        width = width * 10U + static_cast<uint32_t>(*spec++ - '0');
+                    }
+                    if (spec[0] == '.' && spec[1] >= '0' && spec[1] <= '8' && spec[2] == 'f' && width <= 0xFFFFU) {
+                        format = spec + 3;
+                        const uint8_t decimals = static_cast<uint8_t>(spec[1] - '0');
+                        const double value = va_arg(args, double);
+                        if (!putFixedField(value, decimals, width, leftAlign, zeroPad)) {
+                            Spec field;
+                            field.leftAlign = leftAlign;
+                            field.zeroPad = zeroPad;
+                            field.width = static_cast<uint16_t>(width);
+                            field.precision = decimals;
+                            putDouble(value, field, 'f');
+                        }
+                        continue;
+                    }
+                    char conversion = *spec;
+                    const bool isLong = (conversion == 'l');
+                    if (isLong) {
+                        conversion = *++spec;
+                    }
+                    const bool isSigned = (conversion == 'd' || conversion == 'i');
+                    const uint8_t base = (isSigned || conversion == 'u') ? 10 : (((conversion | 0x20) == 'x') ? 16 : 0);
+                    if (base != 0 && width <= 0xFFFFU) {
+                        format = spec + 1;
+                        uint64_t magnitude;
+                        bool negative = false;
+                        if (isSigned) {
+                            const int64_t value = isLong ? static_cast<int64_t>(va_arg(args, long)) : va_arg(args, int);
+                            negative = (value < 0);
+                            magnitude = negative ? (0ULL - static_cast<uint64_t>(value)) : static_cast<uint64_t>(value);
+                        } else {
+                            magnitude = isLong ? static_cast<uint64_t>(va_arg(args, unsigned long)) : va_arg(args, unsigned int);
+                        }
+                        const bool uppercase = (conversion == 'X');
+                        if (magnitude > 0xFFFFFFFFULL ||
+                            !putIntegerField(static_cast<uint32_t>(magnitude), negative, width, leftAlign, zeroPad, base, uppercase)) {
+                            Spec field;
+                            field.leftAlign = leftAlign;
+                            field.zeroPad = zeroPad;
+                            field.width = static_cast<uint16_t>(width);
+                            putInteger(magnitude, negative, field, base, uppercase);
+                        }
+                        continue;
+                    }
+                }
+
+                Spec spec;
+                for (;; format++) {
+                    if (*format == '-') {
+                        spec.leftAlign = true;
+                    } else if (*format == '0') {
+                        spec.zeroPad = true;
+                    } else if (*format == '+') {
+                        spec.plusSign = true;
+                    } else if (*format == ' ') {
+                        spec.spaceSign = true;
+                    } else if (*format == '#') {
+                        spec.alternate = true;
+                    } else {
+                        break;
+                    }
+                }
+
+                if (*format == '*') {
+                    int width = va_arg(args, int);
+                    if (width < 0) {
+                        spec.leftAlign = true;
+                        width = -width;
+                    }
+                    spec.width = static_cast<uint16_t>(width);
+                    format++;
+                } else {
+                    while (*format >= '0' && *format <= '9') {
+                        spec.width = static_cast<uint16_t>(spec.width * 10 + (*format++ - '0'));
+                    }
+                }
+
+                if (*format == '.') {
+                    format++;
+                    if (*format == '*') {
+                        const int precision = va_arg(args, int);
+                        spec.precision = (precision < 0) ? -1 : static_cast<int16_t>(precision);
+                        format++;
+                    } else {
+                        spec.precision = 0;
+                        while (*format >= '0' && *format <= '9') {
+                            spec.precision = static_cast<int16_t>(spec.precision * 10 + (*format++ - '0'));
+                        }
+                    }
+                }
+
+                // Length modifier: 0 = int, 1 = long, 2 = long long, 3 = size_t/ptrdiff_t, 4 = intmax_t,
+                // 5 = short, 6 = char (passed promoted to int, narrowed back below)
+                uint8_t lengthModifier = 0;
+                switch (*format) {
+                    case 'h':
+                        format++;
+                        lengthModifier = 5;
+                        if (*format == 'h') {
+                            format++;
+                            lengthModifier = 6;
+                        }
+                        break;
+                    case 'l':
+                        format++;
+                        lengthModifier = 1;
+                        if (*format == 'l') {
+                            format++;
+                            lengthModifier = 2;
+                        }
+                        break;
+                    case 'z':
+                    case 't':
+                        format++;
+                        lengthModifier = 3;
+                        break;
+                    case 'j':
+                        format++;
+                        lengthModifier = 4;
+                        break;
+                    default:
+                        break;
+                }
+
+                const char conversion = *format;
+                if (conversion == '\0') {
+                    break;
+                }
+                format++;
+
+                switch (conversion) {
+                    case 'd':
+                    case 'i': {
+                        int64_t value;
+                        switch (lengthModifier) {
+                            case 1:  value = va_arg(args, long); break;
+                            case 2:  value = va_arg(args, long long); break;
+                            case 3:  value = va_arg(args, ptrdiff_t); break;
+                            case 4:  value = va_arg(args, intmax_t); break;
+                            case 5:  value = static_cast<short>(va_arg(args, int)); break;
+                            case 6:  value = static_cast<signed char>(va_arg(args, int)); break;
+                            default: value = va_arg(args, int); break;
+                        }
+                        const bool negative = (value < 0);
+                        const uint64_t magnitude = negative ? (0ULL - static_cast<uint64_t>(value)) : static_cast<uint64_t>(value);
+                        putInteger(magnitude, negative, spec, 10, false);
+                        break;
+                    }
+                    case 'u':
+                    case 'x':
+                    case 'X':
+                    case 'o': {
+                        uint64_t value;
+                        switch (lengthModifier) {
+                            case 1:  value = va_arg(args, unsigned long); break;
+                            case 2:  value = va_arg(args, unsigned long long); break;
+                            case 3:  value = va_arg(args, size_t); break;
+                            case 4:  value = va_arg(args, uintmax_t); break;
+                            case 5:  value = static_cast<unsigned short>(va_arg(args, unsigned int)); break;
+                            case 6:  value = static_cast<unsigned char>(va_arg(args, unsigned int)); break;
+                            default: value = va_arg(args, unsigned int); break;
+                        }
+                        // '+' and ' ' apply to signed conversions only
+                        spec.plusSign = false;
+                        spec.spaceSign = false;
+                        const uint8_t base = (conversion == 'u') ? 10 : ((conversion == 'o') ? 8 : 16);
+                        putInteger(value, false, spec, base, conversion == 'X');
+                        break;
+                    }
+                    case 'p': {
+                        spec.alternate = true;
+                        putInteger(reinterpret_cast<uintptr_t>(va_arg(args, void*)), false, spec, 16, false);
+                        break;
+                    }
+                    case 'c': {
+                        const char value = static_cast<char>(va_arg(args, int));
+                        Spec charSpec = spec;
+                        charSpec.precision = -1;
+                        const uint16_t padding = (spec.width > 1) ? static_cast<uint16_t>(spec.width - 1) : 0;
+                        if (!charSpec.leftAlign) {
+                            putRepeated(' ', padding);
+                        }
+                        putChar(value);
+                        if (charSpec.leftAlign) {
+                            putRepeated(' ', padding);
+                        }
+                        break;
+                    }
+                    case 's':
+                        putStringField(va_arg(args, const char*), spec);
+                        break;
+                    case 'f':
+                    case 'F':
+                    case 'e':
+                    case 'E':
+                    case 'g':
+                    case 'G':
+                        putDouble(va_arg(args, double), spec, conversion);
+                        break;
+                    case '%':
+                        putChar('%');
+                        break;
+                    default:
+                        // Unknown conversion: echo it so the problem is visible in the log
+                        putChar('%');
+                        putChar(conversion);
+                        break;
+                }
+            }
+        }
+
+        /**
+         * @brief Render a printf-style format string
+         * @param format Format string
+         * @param ... Arguments
+         */
+        void format(const char* format, ...) {
+            va_list args;
+            va_start(args, format);
+            vformat(format, args);
+            va_end(args);
+        }
+
+        /**
+         * @brief Publish the pending region
+         * @return Number of bytes written since construction
+         */
+        uint16_t finish() {
+            const uint16_t used = static_cast<uint16_t>(cursor - region);
+            if (used > 0) {
+                sink.publish(used);
+                published = static_cast<uint16_t>(published + used);
+                region = cursor;
+            }
+            return published;
+        }
+
+        /**
+         * @brief Check if output was dropped because the sink ran full
+         */
+        bool isTruncated() const {
+            return truncated;
+        }
+    };
+
+    template<typename Sink>
+    constexpr uint32_t StreamFormatter<Sink>::POW10[10];
+
+    template<typename Sink>
+    constexpr double StreamFormatter<Sink>::POW10_DOUBLE[MAX_DECIMALS + 1];
+
+    template<typename Sink>
+    constexpr double StreamFormatter<Sink>::POW10_BINARY[9];
+
+    template<typename Sink>
+    constexpr char StreamFormatter<Sink>::DIGIT_PAIRS[201];
+
+} // namespace FORMAT
+
+#endif /* INC_STREAM_FORMATTER_H_ */
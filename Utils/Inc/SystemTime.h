@@ -0,0 +1,132 @@
+/**
+ * @file    SystemTime.h
+ * @brief   Monotonic 64-bit time base from the SysTick counter
+ *
+ * SysTick (1 ms, configured by LL_Init1msTick) counts the processor clock and,
+ * unlike the core and its DWT cycle counter, keeps counting in Sleep mode. A
+ * 64-bit base advances by one period on every wrap, and the current count
+ * supplies the fraction, so time has one-cycle resolution and includes the
+ * time spent in WFI:
+ *
+ * @code
+ * cycles = base + (LOAD - VAL)      // base advanced on COUNTFLAG
+ * @endcode
+ *
+ * The wrap is taken from COUNTFLAG by whichever context reads the time first
+ * (the SysTick interrupt or any reader), inside a critical section of a few
+ * instructions, so readers of any priority get consistent values. A wrap is
+ * lost only if SysTick goes unserviced for a whole period, i.e. if interrupts
+ * stay masked or higher-priority handlers run for more than 1 ms.
+ *
+ * sleep() stretches the SysTick period to 2^24 cycles (524 ms at 32 MHz) for a
+ * tickless WFI and restores it on wake-up. Each stretch and restore loses the
+ * few cycles between reading and restarting the counter.
+ *
+ * @note Nothing else may read SysTick->CTRL (reading clears COUNTFLAG); in
+ *       particular LL_mDelay() must not be used after init().
+ */
+
+#ifndef INC_SYSTEM_TIME_H_
+#define INC_SYSTEM_TIME_H_
+
+#include "main.h"
+#include "CycleCounter.h"
+
+#include <cstdint>
+
+namespace TIME
+{
+    /**
+     * @brief Start the time base and the SysTick interrupt
+     * @note Call once after SystemClock_Config()
+     */
+    void init();
+
+    /**
+     * @brief SysTick interrupt work: account the elapsed period
+     */
+    void handleTick();
+
+    /**
+     * @brief Sleep in WFI until an interrupt is pending
+     *
+     * The caller masks interrupts around its idle check and this call; the
+     * waking interrupt runs once it unmasks them.
+     *
+     * @param tickless Stretch the SysTick period so the tick does not wake the
+     *                 core (another interrupt, e.g. TIM7, must bound the sleep)
+     * @return Cycles spent asleep, counted by SysTick
+     */
+    uint32_t sleep(bool tickless);
+
+    /**
+     * @brief Core cycles since init() (64-bit, monotonic)
+     */
+    uint64_t nowCycles();
+
+    /**
+     * @brief Low 32 bits of nowCycles(), for timestamps compared by unsigned subtraction
+     *
+     * Unlike TIME::cycles() (DWT) it keeps counting while the core sleeps in WFI.
+     * Differences are exact for intervals below 2^32 cycles (134 s at 32 MHz).
+     */
+    inline uint32_t nowCycles32() {
+        return static_cast<uint32_t>(nowCycles());
+    }
+
+    /**
+     * @brief Microseconds since init() (64-bit, monotonic)
+     */
+    uint64_t nowUs();
+
+    /**
+     * @brief Milliseconds since init() (wraps after 49 days)
+     */
+    uint32_t nowMs();
+
+    /**
+     * @brief Sleep until an absolute time
+     *
+     * Waits in WFI while at least one SysTick period remains (any interrupt wakes
+     * the core early and the wait resumes), then spins on the time base for the
+     * last fraction of a millisecond.
+     *
+     * @param deadlineUs Absolute time in microseconds (as returned by nowUs())
+     */
+    void delayUntil(uint64_t deadlineUs);
+
+    /**
+     * @brief Sleep for a duration
+     * @param us Microseconds to wait
+     */
+    inline void delayUs(uint32_t us) {
+        delayUntil(nowUs() + us);
+    }
+
+    /**
+     * @brief Sleep until the next multiple of a period, for drift-free loops
+     *
+     * @code
+     * uint64_t next = TIME::nowUs();
+     * while (true) { work(); TIME::delayPeriodic(next, 1000); }
+     * @endcode
+     *
+     * @param deadlineUs Previous deadline, advanced by periodUs
+     * @param periodUs Period in microseconds
+     */
+    inline void delayPeriodic(uint64_t& deadlineUs, uint32_t periodUs) {
+        deadlineUs += periodUs;
+        delayUntil(deadlineUs);
+    }
+
+} // namespace TIME
+
+extern "C" {
+    /**
+     * @brief C entry points for main.c and stm32l4xx_it.c
+     */
+    void TIME_Init(void);
+    void TIME_HandleSysTick(void);
+}
+
+#endif /* INC_SYSTEM_TIME_H_ */
@@ -0,0 +1,63 @@
+/**
+ * @file    Arena.cpp
+ * @brief   Init-phase bump arena and allocation freeze
+ */
+
+#include "Arena.h"
+#include "CriticalSection.h"
+
+namespace MEMORY
+{
+    static_assert((MEMORY_INIT_ARENA_SIZE % 8U) == 0, "MEMORY_INIT_ARENA_SIZE must be a multiple of 8");
+
+    alignas(8) static uint8_t initStorage[MEMORY_INIT_ARENA_SIZE];
+    static Arena initArena(initStorage, MEMORY_INIT_ARENA_SIZE);   // Constant-initialised
+    static volatile bool frozen = false;
+    static volatile uint32_t hotPathAllocations = 0;
+
+    void* Arena::allocate(size_t size) {
+        const size_t rounded = arenaFootprint(size);
+        CriticalSection lock;
+        if (rounded > static_cast<size_t>(end_ - next_)) {
+            return nullptr;
+        }
+        void* block = next_;
+        next_ += rounded;
+        return block;
+    }
+
+    void* allocateInit(size_t size) {
+        if (frozen) {
+            return nullptr;
+        }
+        return initArena.allocate(size);
+    }
+
+    void freeze() {
+        frozen = true;
+    }
+
+    bool isFrozen() {
+        return frozen;
+    }
+
+    void noteHotPathAllocation() {
+#if (MEMORY_FREEZE_TRAP == 1)
+        Error_Handler();
+#else
+        uint32_t value;
+        do {
+            value = __LDREXW(&hotPathAllocations);
+        } while (__STREXW(value + 1U, &hotPathAllocations) != 0);
+#endif
+    }
+
+    uint32_t getHotPathAllocations() {
+        return hotPathAllocations;
+    }
+
+    const Arena& getInitArena() {
+        return initArena;
+    }
+
+} // namespace MEMORY
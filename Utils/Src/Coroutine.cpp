@@ -0,0 +1,150 @@
+/**
+ * @file    Coroutine.cpp
+ * @brief   Coroutine executor and static frame pool
+ */
+
+#include "Coroutine.h"
+
+#if defined(__cpp_impl_coroutine)
+
+namespace CORO
+{
+    static_assert(CORO_MAX_TASKS <= 32U, "CORO_MAX_TASKS must fit the ready mask");
+    static_assert((CORO_FRAME_SIZE % 8U) == 0, "CORO_FRAME_SIZE must keep frames 8-byte aligned");
+
+    // Frames are allocated and freed in thread mode only (coroutine call, runReady)
+    alignas(8) static uint8_t framePool[CORO_MAX_TASKS][CORO_FRAME_SIZE];
+    static uint32_t framesUsed = 0;
+
+    //=========================================================================
+    // Frame pool
+    //=========================================================================
+
+    void* Task::promise_type::operator new(size_t size) noexcept {
+        const uint32_t free = ~framesUsed & ((CORO_MAX_TASKS == 32U) ? 0xFFFFFFFFUL : ((1UL << CORO_MAX_TASKS) - 1U));
+        if (size > CORO_FRAME_SIZE || free == 0) {
+            return nullptr;     // get_return_object_on_allocation_failure()
+        }
+        const uint32_t index = __CLZ(__RBIT(free));
+        framesUsed |= 1UL << index;
+        return framePool[index];
+    }
+
+    void Task::promise_type::operator delete(void* frame) noexcept {
+        const uint32_t index = static_cast<uint32_t>(
+            (static_cast<uint8_t*>(frame) - &framePool[0][0]) / CORO_FRAME_SIZE);
+        framesUsed &= ~(1UL << index);
+    }
+
+    //=========================================================================
+    // Executor
+    //=========================================================================
+
+    bool Executor::spawn(Task task) {
+        if (!task.isValid()) {
+            return false;
+        }
+        const uint32_t mask = (CORO_MAX_TASKS == 32U) ? 0xFFFFFFFFUL : ((1UL << CORO_MAX_TASKS) - 1U);
+        const uint32_t free = ~used_ & mask;
+        if (free == 0) {
+            return false;       // task is destroyed with its frame
+        }
+
+        const uint32_t slot = __CLZ(__RBIT(free));
+        Task::promise_type& promise = task.handle_.promise();
+        promise.executor = this;
+        promise.slot = slot;
+
+        Slot& entry = slots_[slot];
+        entry.handle = task.handle_;
+        entry.check = nullptr;
+        entry.context = nullptr;
+        entry.armed = 0;
+        task.handle_ = nullptr;
+        used_ |= 1UL << slot;
+
+        setReady(slot);         // Runs up to its first co_await in runReady()
+        return true;
+    }
+
+    uint32_t Executor::runReady() {
+        uint32_t pending;
+        do {
+            pending = __LDREXW(&ready_);
+        } while (__STREXW(0U, &ready_) != 0);
+
+        uint32_t resumed = 0;
+        pending = __RBIT(pending);
+        while (pending != 0) {
+            const uint32_t slot = __CLZ(pending);
+            pending &= ~(0x80000000UL >> slot);
+
+            Slot& entry = slots_[slot];
+            if (!entry.handle) {
+                continue;
+            }
+            if (entry.check && !entry.check(entry.context)) {
+                // Woken but not complete (e.g. part of a line): wait again
+                entry.armed = 1;
+                if (!entry.check(entry.context) || !disarm(slot)) {
+                    continue;
+                }
+            }
+
+            entry.check = nullptr;
+            entry.handle.resume();
+            resumed++;
+
+            if (entry.handle.done()) {
+                entry.handle.destroy();
+                entry.handle = nullptr;
+                used_ &= ~(1UL << slot);
+            }
+        }
+        return resumed;
+    }
+
+    void Executor::arm(uint32_t slot, Check check, void* context) {
+        Slot& entry = slots_[slot];
+        entry.check = check;
+        entry.context = context;
+        entry.armed = 1;
+    }
+
+    bool Executor::commit(uint32_t slot) {
+        Slot& entry = slots_[slot];
+        if (entry.check && entry.check(entry.context) && disarm(slot)) {
+            entry.check = nullptr;
+            return false;       // Completed before suspending: continue at once
+        }
+        return true;
+    }
+
+    void Executor::wake(uint32_t slot) {
+        if (slot < CORO_MAX_TASKS && disarm(slot)) {
+            setReady(slot);
+        }
+    }
+
+    /**
+     * @brief Clear the armed flag; only the first of concurrent callers wins
+     */
+    bool Executor::disarm(uint32_t slot) {
+        volatile uint32_t* armed = &slots_[slot].armed;
+        uint32_t value;
+        do {
+            value = __LDREXW(armed);
+        } while (__STREXW(0U, armed) != 0);
+        return value != 0;
+    }
+
+    void Executor::setReady(uint32_t slot) {
+        uint32_t value;
+        do {
+            value = __LDREXW(&ready_);
+        } while (__STREXW(value | (1UL << slot), &ready_) != 0);
+    }
+
+} // namespace CORO
+
+#endif /* __cpp_impl_coroutine */
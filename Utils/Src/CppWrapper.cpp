@@ -8,6 +8,9 @@
 
 
 #include "App.h"
+#include "MemoryPool.h"
+#include "Arena.h"
+#include "MemoryStats.h"
 
 #include <new>
 #include <typeindex>
@@ -17,12 +20,41 @@
 #include <cstdlib>
 #include <cstdio>
 
-// C++ operator new/delete overrides for ST Newlib integration
-// These use standard malloc/free which are thread-safe via heap_useNewlib_ST.c
+// C++ operator new/delete overrides
+// Init-phase objects come from the bump arena in Arena.cpp; everything else,
+// and everything after MEMORY::freeze(), from the fixed-block pools in MemoryPool.cpp
+
+static void* allocate(size_t size)
+{
+    void* ptr = MEMORY::allocateInit(size);
+    if (!ptr) {
+        if (MEMORY::isFrozen()) {
+            MEMORY::noteHotPathAllocation();
+        }
+        ptr = MEMORY::allocate(size);
+    }
+    if (ptr) {
+        MEMORY::recordAllocation(size, ptr);
+    } else {
+        MEMORY::recordFailure(size);
+    }
+    return ptr;
+}
+
+static void release(void* ptr)
+{
+    if (!ptr) {
+        return;
+    }
+    MEMORY::recordRelease(ptr);
+    if (!MEMORY::getInitArena().owns(ptr)) {   // Arena memory is never reused
+        MEMORY::release(ptr);
+    }
+}
 
 void* operator new(size_t size)
 {
-    void* ptr = malloc(size);
+    void* ptr = allocate(size);
     if (!ptr)
     {
         // For embedded systems: Go into error handler to stop system
@@ -33,7 +65,7 @@ void* operator new(size_t size)
 
 void* operator new[](size_t size)
 {
-    void* ptr = malloc(size);
+    void* ptr = allocate(size);
     if (!ptr)
     {
         // For embedded systems: Go into error handler to stop system
@@ -44,33 +76,25 @@ void* operator new[](size_t size)
 
 void operator delete(void* ptr) noexcept
 {
-    if (ptr) {
-        free(ptr);
-    }
+    release(ptr);
 }
 
 void operator delete[](void* ptr) noexcept
 {
-    if (ptr) {
-        free(ptr);
-    }
+    release(ptr);
 }
 
 // C++14 sized delete operators
 void operator delete(void* ptr, size_t size) noexcept
 {
-    (void)size; // Suppress unused parameter warning
-    if (ptr) {
-        free(ptr);
-    }
+    (void)size; // The owning pool is found from the address
+    release(ptr);
 }
 
 void operator delete[](void* ptr, size_t size) noexcept
 {
-    (void)size; // Suppress unused parameter warning
-    if (ptr) {
-        free(ptr);
-    }
+    (void)size; // The owning pool is found from the address
+    release(ptr);
 }
 
 
@@ -0,0 +1,117 @@
+/**
+ * @file    EventLoop.cpp
+ * @brief   Run-to-completion event loop that sleeps between events
+ */
+
+#include "EventLoop.h"
+#include "SystemTime.h"
+#include "CriticalSection.h"
+
+namespace LOOP
+{
+    static_assert(EVENT_LOOP_MAX_TASKS <= 32U, "EVENT_LOOP_MAX_TASKS must fit the signal word");
+
+    EventLoop::EventLoop(TIMER::TimerWheel* wheel)
+        : wheel_(wheel)
+    {
+    }
+
+    int32_t EventLoop::addTask(Handler handler, void* context, Ready ready) {
+        if (handler == nullptr || taskCount_ >= EVENT_LOOP_MAX_TASKS) {
+            return INVALID_TASK;
+        }
+        tasks_[taskCount_] = Task{handler, ready, context};
+        return static_cast<int32_t>(taskCount_++);
+    }
+
+    uint32_t EventLoop::runOnce() {
+        uint32_t count = 0;
+        if (wheel_) {
+            count += wheel_->runDeferred();
+        }
+
+        const uint32_t signalled = takeSignals();
+        for (uint32_t i = 0; i < taskCount_; i++) {
+            const Task& task = tasks_[i];
+            if ((signalled & (1UL << i)) || task.ready == nullptr || task.ready(task.context)) {
+                task.handler(task.context);
+                count++;
+                dispatches_++;
+            }
+        }
+        return count;
+    }
+
+    void EventLoop::idle() {
+        CriticalSection lock;               // The waking interrupt runs when the guard ends
+        if (hasWork()) {
+            return;
+        }
+
+        // Tickless: the wheel programs the next wake-up. Sleep time is counted
+        // by SysTick, which keeps running in Sleep mode
+        idleCycles_ += TIME::sleep(wheel_ != nullptr);
+        sleeps_++;
+    }
+
+    void EventLoop::run() {
+        resetStats();
+
+        while (true) {
+            runOnce();
+            idle();
+        }
+    }
+
+    Stats EventLoop::getStats() const {
+        Stats stats;
+        stats.elapsedCycles = TIME::nowCycles() - windowStart_;
+        stats.idleCycles = idleCycles_;
+        stats.sleeps = sleeps_;
+        stats.dispatches = dispatches_;
+        return stats;
+    }
+
+    uint32_t EventLoop::getLoadPermille() const {
+        const Stats stats = getStats();
+        if (stats.elapsedCycles == 0 || stats.idleCycles >= stats.elapsedCycles) {
+            return 0;
+        }
+        return static_cast<uint32_t>(((stats.elapsedCycles - stats.idleCycles) * 1000U) / stats.elapsedCycles);
+    }
+
+    void EventLoop::resetStats() {
+        windowStart_ = TIME::nowCycles();
+        idleCycles_ = 0;
+        sleeps_ = 0;
+        dispatches_ = 0;
+    }
+
+    /**
+     * @brief Check for work with interrupts masked
+     */
+    bool EventLoop::hasWork() {
+        if (signals_ != 0 || (wheel_ && wheel_->hasDeferred())) {
+            return true;
+        }
+        for (uint32_t i = 0; i < taskCount_; i++) {
+            const Task& task = tasks_[i];
+            if (task.ready && task.ready(task.context)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Read and clear the signal word
+     */
+    uint32_t EventLoop::takeSignals() {
+        uint32_t value;
+        do {
+            value = __LDREXW(&signals_);
+        } while (__STREXW(0U, &signals_) != 0);
+        return value;
+    }
+
+} // namespace LOOP
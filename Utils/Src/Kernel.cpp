@@ -0,0 +1,519 @@
+/**
+ * @file    Kernel.cpp
+ * @brief   Scheduler, mutexes and the PendSV context switch
+ */
+
+#include "Kernel.h"
+#include "StackMonitor.h"
+#include "CriticalSection.h"
+
+static_assert(KERNEL_MAX_PRIORITY <= 31U, "KERNEL_MAX_PRIORITY must fit the ready mask");
+static_assert(KERNEL_MAIN_PRIORITY >= 1U && KERNEL_MAIN_PRIORITY <= KERNEL_MAX_PRIORITY,
+              "KERNEL_MAIN_PRIORITY must be a thread priority");
+
+extern "C" {
+    // Shared with PendSV_Handler: the thread whose context is on the CPU, and the
+    // one the scheduler selected. They differ only while PendSV is pending.
+    KERNEL::Thread* volatile kernelCurrent = nullptr;
+    KERNEL::Thread* volatile kernelNext = nullptr;
+}
+
+namespace KERNEL
+{
+    static constexpr uint32_t INITIAL_XPSR = 0x01000000UL;          // Thumb state
+    static constexpr uint32_t INITIAL_EXC_RETURN = 0xFFFFFFFDUL; // No FPU frame
+    static constexpr uint8_t IDLE_PRIORITY = 0;
+
+    static void idleMain(void*);
+
+    KERNEL_THREAD_STACK static uint32_t idleStack[KERNEL_IDLE_STACK_WORDS];
+
+    /**
+     * @brief Scheduler state; all members are used with interrupts masked
+     */
+    struct Scheduler
+    {
+        static Thread* readyHead[KERNEL_MAX_PRIORITY + 1U];
+        static Thread* readyTail[KERNEL_MAX_PRIORITY + 1U];
+        static uint32_t readyMask;          ///< Bit n = a thread of priority n is ready
+        static Thread* allThreads;          ///< Registry for stack checks
+        static TIMER::TimerWheel* wheel;
+        static bool running;
+        static Thread mainThread;
+        static Thread idleThread;
+
+        static void pushBack(Thread& thread) {
+            const uint8_t priority = thread.priority_;
+            thread.next_ = nullptr;
+            if (readyTail[priority]) {
+                readyTail[priority]->next_ = &thread;
+            } else {
+                readyHead[priority] = &thread;
+            }
+            readyTail[priority] = &thread;
+            readyMask |= 1UL << priority;
+        }
+
+        static void pushFront(Thread& thread) {
+            const uint8_t priority = thread.priority_;
+            thread.next_ = readyHead[priority];
+            if (readyHead[priority] == nullptr) {
+                readyTail[priority] = &thread;
+            }
+            readyHead[priority] = &thread;
+            readyMask |= 1UL << priority;
+        }
+
+        static Thread* popFront(uint8_t priority) {
+            Thread* thread = readyHead[priority];
+            readyHead[priority] = thread->next_;
+            if (readyHead[priority] == nullptr) {
+                readyTail[priority] = nullptr;
+                readyMask &= ~(1UL << priority);
+            }
+            thread->next_ = nullptr;
+            return thread;
+        }
+
+        static void removeReady(Thread& thread) {
+            const uint8_t priority = thread.priority_;
+            Thread* previous = nullptr;
+            for (Thread* entry = readyHead[priority]; entry; previous = entry, entry = entry->next_) {
+                if (entry != &thread) {
+                    continue;
+                }
+                if (previous) {
+                    previous->next_ = entry->next_;
+                } else {
+                    readyHead[priority] = entry->next_;
+                }
+                if (readyTail[priority] == entry) {
+                    readyTail[priority] = previous;
+                }
+                if (readyHead[priority] == nullptr) {
+                    readyMask &= ~(1UL << priority);
+                }
+                break;
+            }
+            thread.next_ = nullptr;
+        }
+
+        static void add(Thread& thread) {
+            CriticalSection lock;
+            thread.nextThread_ = allThreads;
+            allThreads = &thread;
+        }
+
+        static void makeReady(Thread& thread) {
+            thread.state_ = ThreadState::READY;
+            pushBack(thread);
+        }
+
+        static void switchTo(Thread& thread) {
+            thread.state_ = ThreadState::RUNNING;
+            if (&thread != kernelNext) {
+                kernelNext = &thread;
+                SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;  // Switch once no ISR is active
+            }
+        }
+
+        /**
+         * @brief Give the CPU to the highest-priority ready thread if it outranks the running one
+         */
+        static void reschedule() {
+            if (!running) {
+                return;
+            }
+            Thread* current = kernelNext;
+            const bool runnable = (current->state_ == ThreadState::RUNNING);
+            if (readyMask == 0) {
+                return;     // Idle thread is running
+            }
+            const uint8_t top = static_cast<uint8_t>(31U - __CLZ(readyMask));
+            if (runnable && current->priority_ >= top) {
+                return;
+            }
+            Thread* next = popFront(top);
+            if (runnable) {
+                current->state_ = ThreadState::READY;
+                pushFront(*current);   // Preempted: first in line at its priority
+            }
+            switchTo(*next);
+        }
+
+        /**
+         * @brief Change the effective priority, keeping queues ordered
+         */
+        static void setPriority(Thread& thread, uint8_t priority) {
+            if (thread.priority_ == priority) {
+                return;
+            }
+            if (thread.state_ == ThreadState::READY) {
+                removeReady(thread);
+                thread.priority_ = priority;
+                pushBack(thread);
+            } else {
+                thread.priority_ = priority;
+            }
+            if (thread.state_ == ThreadState::BLOCKED && thread.waitingOn_) {
+                Mutex& mutex = *thread.waitingOn_;
+                removeWaiter(mutex, thread);
+                insertWaiter(mutex, thread);
+            }
+        }
+
+        static void insertWaiter(Mutex& mutex, Thread& thread) {
+            Thread** link = &mutex.waiters_;
+            while (*link && (*link)->priority_ >= thread.priority_) {
+                link = &(*link)->next_;
+            }
+            thread.next_ = *link;
+            *link = &thread;
+        }
+
+        static void removeWaiter(Mutex& mutex, Thread& thread) {
+            for (Thread** link = &mutex.waiters_; *link; link = &(*link)->next_) {
+                if (*link == &thread) {
+                    *link = thread.next_;
+                    break;
+                }
+            }
+            thread.next_ = nullptr;
+        }
+
+        static void acquire(Mutex& mutex, Thread& thread) {
+            mutex.owner_ = &thread;
+            mutex.nextHeld_ = thread.held_;
+            thread.held_ = &mutex;
+        }
+
+        /**
+         * @brief Raise the owner chain of a mutex to at least a priority
+         */
+        static void inherit(Thread* owner, uint8_t priority) {
+            while (owner && owner->priority_ < priority) {
+                setPriority(*owner, priority);
+                if (owner->state_ != ThreadState::BLOCKED || owner->waitingOn_ == nullptr) {
+                    break;
+                }
+                owner = owner->waitingOn_->owner_;
+            }
+        }
+
+        /**
+         * @brief Base priority raised to the best waiter of every mutex still held
+         */
+        static uint8_t inheritedPriority(const Thread& thread) {
+            uint8_t priority = thread.basePriority_;
+            for (const Mutex* mutex = thread.held_; mutex; mutex = mutex->nextHeld_) {
+                if (mutex->waiters_ && mutex->waiters_->priority_ > priority) {
+                    priority = mutex->waiters_->priority_;
+                }
+            }
+            return priority;
+        }
+
+        /**
+         * @brief Entry functions return here
+         */
+        static void exitThread() {
+            {
+                CriticalSection lock;
+                kernelNext->state_ = ThreadState::TERMINATED;
+                reschedule();
+            }
+            while (true) {
+                // PendSV switches away as soon as interrupts are enabled
+            }
+        }
+
+        static void start(TIMER::TimerWheel* timerWheel) {
+            wheel = timerWheel;
+            idleThread.basePriority_ = IDLE_PRIORITY;
+            idleThread.priority_ = IDLE_PRIORITY;
+            makeReady(idleThread);
+
+            mainThread.state_ = ThreadState::RUNNING;
+            kernelCurrent = &mainThread;
+            kernelNext = &mainThread;
+            running = true;
+
+            reschedule();       // Threads started before the kernel
+        }
+
+        static void yield() {
+            Thread& current = *kernelNext;
+            if (readyHead[current.priority_] == nullptr) {
+                return;         // Nobody else at this priority (higher ones would already run)
+            }
+            current.state_ = ThreadState::READY;
+            pushBack(current);
+            switchTo(*popFront(current.priority_));
+        }
+
+        static void sleep(uint32_t ticks) {
+            Thread& current = *kernelNext;
+            current.state_ = ThreadState::SLEEPING;
+            wheel->startOneShot(current.sleepTimer_, ticks);
+            reschedule();
+        }
+    };
+
+    Thread* Scheduler::readyHead[KERNEL_MAX_PRIORITY + 1U] = {};
+    Thread* Scheduler::readyTail[KERNEL_MAX_PRIORITY + 1U] = {};
+    uint32_t Scheduler::readyMask = 0;
+    Thread* Scheduler::allThreads = nullptr;
+    TIMER::TimerWheel* Scheduler::wheel = nullptr;
+    bool Scheduler::running = false;
+    Thread Scheduler::mainThread("main", KERNEL_MAIN_PRIORITY);
+    Thread Scheduler::idleThread(idleMain, nullptr, idleStack, 1, "idle");
+
+    //=========================================================================
+    // Thread
+    //=========================================================================
+
+    static uint8_t clampPriority(uint8_t priority) {
+        if (priority < 1U) {
+            return 1U;
+        }
+        return (priority > KERNEL_MAX_PRIORITY) ? static_cast<uint8_t>(KERNEL_MAX_PRIORITY) : priority;
+    }
+
+    Thread::Thread(Entry entry, void* argument, uint32_t* stack, uint32_t stackWords, uint8_t priority, const char* name)
+        : stackBase_(stack), stackWords_(stackWords), name_(name),
+          sleepTimer_(onSleepExpired, this),
+          basePriority_(clampPriority(priority)), priority_(clampPriority(priority))
+    {
+        STACK::paint(stack, stackWords);
+        Scheduler::add(*this);
+
+        // Exception frame as if the thread had been preempted right before its first instruction
+        uint32_t* sp = reinterpret_cast<uint32_t*>(reinterpret_cast<uintptr_t>(stack + stackWords) & ~static_cast<uintptr_t>(7U));
+        *--sp = INITIAL_XPSR;
+        *--sp = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(entry)) & ~1UL;  // PC
+        *--sp = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&Scheduler::exitThread));  // LR
+        *--sp = 0;                                                                  // R12
+        *--sp = 0;                                                                  // R3
+        *--sp = 0;                                                                  // R2
+        *--sp = 0;                                                                  // R1
+        *--sp = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(argument));     // R0
+
+        // Software frame popped by PendSV: R4-R11 and EXC_RETURN
+        *--sp = INITIAL_EXC_RETURN;
+        for (uint32_t i = 0; i < 8U; i++) {
+            *--sp = 0;
+        }
+        sp_ = sp;
+    }
+
+    Thread::Thread(const char* name, uint8_t priority)
+        : sp_(nullptr), stackBase_(nullptr), stackWords_(0), name_(name),
+          sleepTimer_(onSleepExpired, this),
+          basePriority_(priority), priority_(priority)
+    {
+        Scheduler::add(*this);
+    }
+
+    void Thread::start() {
+        CriticalSection lock;
+        if (state_ != ThreadState::CREATED) {
+            return;
+        }
+        Scheduler::makeReady(*this);
+        Scheduler::reschedule();
+    }
+
+    /**
+     * @brief Sleep timer callback (TIM7 interrupt context)
+     */
+    void Thread::onSleepExpired(void* thread) {
+        CriticalSection lock;
+        Thread& sleeper = *static_cast<Thread*>(thread);
+        if (sleeper.state_ == ThreadState::SLEEPING) {
+            Scheduler::makeReady(sleeper);
+            Scheduler::reschedule();
+        }
+    }
+
+    /**
+     * @brief Runs only when every other thread, the main thread included, is blocked
+     */
+    static void idleMain(void*) {
+        while (true) {
+            __WFI();
+        }
+    }
+
+    //=========================================================================
+    // Mutex
+    //=========================================================================
+
+    void Mutex::lock() {
+        if (!Scheduler::running) {
+            return;     // Single-threaded until start()
+        }
+        CriticalSection lock;
+        Thread& current = *kernelNext;
+        if (owner_ == nullptr) {
+            Scheduler::acquire(*this, current);
+            return;
+        }
+
+        current.state_ = ThreadState::BLOCKED;
+        current.waitingOn_ = this;
+        Scheduler::insertWaiter(*this, current);
+        Scheduler::inherit(owner_, current.priority_);
+        Scheduler::reschedule();
+        // PendSV runs when the guard unmasks interrupts; we resume as the owner
+    }
+
+    bool Mutex::tryLock() {
+        if (!Scheduler::running) {
+            return true;
+        }
+        CriticalSection lock;
+        if (owner_ != nullptr) {
+            return false;
+        }
+        Scheduler::acquire(*this, *kernelNext);
+        return true;
+    }
+
+    void Mutex::unlock() {
+        if (!Scheduler::running) {
+            return;
+        }
+        CriticalSection lock;
+        Thread& current = *kernelNext;
+        if (owner_ != &current) {
+            return;
+        }
+
+        for (Mutex** link = &current.held_; *link; link = &(*link)->nextHeld_) {
+            if (*link == this) {
+                *link = nextHeld_;
+                break;
+            }
+        }
+        nextHeld_ = nullptr;
+        owner_ = nullptr;
+
+        // Direct hand-over: the best waiter owns the mutex before it runs again
+        Thread* next = waiters_;
+        if (next) {
+            waiters_ = next->next_;
+            next->next_ = nullptr;
+            next->waitingOn_ = nullptr;
+            Scheduler::acquire(*this, *next);
+            Scheduler::setPriority(*next, Scheduler::inheritedPriority(*next));
+            Scheduler::makeReady(*next);
+        }
+
+        Scheduler::setPriority(current, Scheduler::inheritedPriority(current));
+        Scheduler::reschedule();
+    }
+
+    //=========================================================================
+    // Kernel API
+    //=========================================================================
+
+    void start(TIMER::TimerWheel* wheel) {
+        CriticalSection lock;
+        if (Scheduler::running) {
+            return;
+        }
+
+#if (__FPU_USED == 1U)
+        // Lazy stacking: S0-S15 are only saved once an ISR or PendSV touches the FPU
+        FPU->FPCCR |= FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk;
+#endif
+        NVIC_SetPriority(PendSV_IRQn, (1UL << __NVIC_PRIO_BITS) - 1U);
+
+        Scheduler::start(wheel);
+    }
+
+    bool isRunning() {
+        return Scheduler::running;
+    }
+
+    Thread* currentThread() {
+        return kernelNext;
+    }
+
+    const Thread* firstThread() {
+        return Scheduler::allThreads;
+    }
+
+    void yield() {
+        if (!Scheduler::running) {
+            return;
+        }
+        CriticalSection lock;
+        Scheduler::yield();
+    }
+
+    void sleepMs(uint32_t ms) {
+        if (!Scheduler::running) {
+            return;
+        }
+        if (Scheduler::wheel == nullptr || ms == 0) {
+            yield();
+            return;
+        }
+        CriticalSection lock;
+        // One extra tick: the current tick is already partly over
+        Scheduler::sleep(TIMER::TimerWheel::msToTicks(ms) + 1U);
+    }
+
+} // namespace KERNEL
+
+/**
+ * @brief Context switch from kernelCurrent to kernelNext
+ *
+ * Saves R4-R11 and EXC_RETURN (plus S16-S31 if the thread has an FPU frame)
+ * on the outgoing stack and restores the incoming one. EXC_RETURN bit 2 selects
+ * the stack: the main thread lives on the MSP, so after saving it the MSP is
+ * moved below its context, where later exceptions nest harmlessly.
+ */
+extern "C" __attribute__((naked)) void PendSV_Handler(void)
+{
+    __asm volatile(
+        "   cpsid   i                               \n"
+        "   movw    r3, #:lower16:kernelCurrent     \n"
+        "   movt    r3, #:upper16:kernelCurrent     \n"
+        "   ldr     r2, [r3]                        \n"
+        "   tst     lr, #4                          \n"
+        "   ite     eq                              \n"
+        "   mrseq   r0, msp                         \n"
+        "   mrsne   r0, psp                         \n"
+#if (__FPU_USED == 1U)
+        "   tst     lr, #0x10                       \n"
+        "   it      eq                              \n"
+        "   vstmdbeq r0!, {s16-s31}                 \n"
+#endif
+        "   stmdb   r0!, {r4-r11, lr}               \n"
+        "   str     r0, [r2]                        \n"
+        "   tst     lr, #4                          \n"
+        "   it      eq                              \n"
+        "   msreq   msp, r0                         \n"
+
+        "   movw    r1, #:lower16:kernelNext        \n"
+        "   movt    r1, #:upper16:kernelNext        \n"
+        "   ldr     r2, [r1]                        \n"
+        "   str     r2, [r3]                        \n"
+        "   ldr     r0, [r2]                        \n"
+        "   ldmia   r0!, {r4-r11, lr}               \n"
+#if (__FPU_USED == 1U)
+        "   tst     lr, #0x10                       \n"
+        "   it      eq                              \n"
+        "   vldmiaeq r0!, {s16-s31}                 \n"
+#endif
+        "   tst     lr, #4                          \n"
+        "   ite     eq                              \n"
+        "   msreq   msp, r0                         \n"
+        "   msrne   psp, r0                         \n"
+        "   isb                                     \n"
+        "   cpsie   i                               \n"
+        "   bx      lr                              \n"
+    );
+}
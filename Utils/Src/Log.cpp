@@ -0,0 +1,89 @@
+/**
+ * @file    Log.cpp
+ * @brief   Record queue in front of the debug UART
+ */
+
+#include "Log.h"
+#include "LogQueue.h"
+#include "usart.h"
+#include "MemorySections.h"
+
+namespace LOG
+{
+    // A record is forwarded whole, so it must fit an empty TX queue or it would stall the queue
+#if LOG_DEFERRED
+    static constexpr uint16_t MAX_TEXT_RECORD = LOG_MAX_FRAME_SIZE - 3U;   // Code byte, ID, delimiter
+#else
+    static constexpr uint16_t MAX_TEXT_RECORD = USART::StandardUSART::TX_CAPACITY;
+#endif
+    static_assert(LOG_MAX_FRAME_SIZE <= USART::StandardUSART::TX_CAPACITY, "Log frames must fit the debug UART TX queue");
+
+    // CPU-only (drained into the UART ring by copying), so it can live in SRAM2
+    RAM2_BSS static RecordQueue<LOG_QUEUE_SIZE> queue;
+
+    /**
+     * @brief Same driver instance that initialise_monitor_handles() set up for printf
+     */
+    static USART::StandardUSART* getDebugUart() {
+        return static_cast<USART::StandardUSART*>(USART_CreateDebugInstance());
+    }
+
+    void flush() {
+        USART::StandardUSART* debug = getDebugUart();
+        if (debug != nullptr) {
+            queue.drain(*debug);
+        }
+    }
+
+    uint32_t getDroppedFrames() {
+        return queue.getDropped();
+    }
+
+    /**
+     * @brief Queue one chunk of printf text, framed as a text record in deferred mode
+     */
+    static bool pushText(const uint8_t* data, uint16_t length) {
+#if LOG_DEFERRED
+        Frame frame;
+        frame.putVarint(TEXT_RECORD_ID);
+        for (uint16_t i = 0; i < length; i++) {
+            frame.put(data[i]);
+        }
+        const uint16_t frameLength = frame.finish();
+        return queue.push(frame.getData(), frameLength);
+#else
+        return queue.push(data, length);
+#endif
+    }
+
+#if LOG_DEFERRED
+    void send(Frame& frame) {
+        // Bytes past the cut are gone, so the decoder would misread the arguments
+        if (frame.isTruncated()) {
+            queue.countDrop();
+            return;
+        }
+        const uint16_t length = frame.finish();
+        if (queue.push(frame.getData(), length)) {
+            flush();
+        }
+    }
+#endif
+
+} // namespace LOG
+
+extern "C" {
+    int LOG_Write(const char* data, int length) {
+        int queued = 0;
+        while (queued < length) {
+            const int remaining = length - queued;
+            const uint16_t chunk = (remaining > LOG::MAX_TEXT_RECORD) ? LOG::MAX_TEXT_RECORD : static_cast<uint16_t>(remaining);
+            if (!LOG::pushText(reinterpret_cast<const uint8_t*>(data + queued), chunk)) {
+                break;
+            }
+            queued += chunk;
+        }
+        LOG::flush();
+        return queued;
+    }
+}
@@ -0,0 +1,109 @@
+/**
+ * @file    MemoryPool.cpp
+ * @brief   Size-class pools and their statically reserved storage
+ */
+
+#include "MemoryPool.h"
+#include "CriticalSection.h"
+
+namespace MEMORY
+{
+    static_assert(MEMORY_POOL_BLOCKS_16 > 0 && MEMORY_POOL_BLOCKS_32 > 0 && MEMORY_POOL_BLOCKS_64 > 0 &&
+                  MEMORY_POOL_BLOCKS_128 > 0 && MEMORY_POOL_BLOCKS_256 > 0,
+                  "Every size class needs at least one block");
+
+    alignas(8) static uint8_t storage16[16U * MEMORY_POOL_BLOCKS_16];
+    alignas(8) static uint8_t storage32[32U * MEMORY_POOL_BLOCKS_32];
+    alignas(8) static uint8_t storage64[64U * MEMORY_POOL_BLOCKS_64];
+    alignas(8) static uint8_t storage128[128U * MEMORY_POOL_BLOCKS_128];
+    alignas(8) static uint8_t storage256[MAX_BLOCK_SIZE * MEMORY_POOL_BLOCKS_256];
+
+    // Smallest class first; constant-initialised (no static constructor)
+    static BlockPool pools[] = {
+        {storage16, 16U, MEMORY_POOL_BLOCKS_16},
+        {storage32, 32U, MEMORY_POOL_BLOCKS_32},
+        {storage64, 64U, MEMORY_POOL_BLOCKS_64},
+        {storage128, 128U, MEMORY_POOL_BLOCKS_128},
+        {storage256, MAX_BLOCK_SIZE, MEMORY_POOL_BLOCKS_256},
+    };
+
+    static constexpr uint32_t POOL_COUNT = sizeof(pools) / sizeof(pools[0]);
+
+    //=========================================================================
+    // BlockPool
+    //=========================================================================
+
+    void* BlockPool::allocate() {
+        CriticalSection lock;
+        void* block;
+        if (free_) {
+            block = free_;
+            free_ = free_->next;
+        } else if (unused_ < end_) {
+            block = unused_;
+            unused_ += blockSize_;
+        } else {
+            exhausted_++;
+            return nullptr;
+        }
+        if (++used_ > peak_) {
+            peak_ = used_;
+        }
+        return block;
+    }
+
+    void BlockPool::release(void* block) {
+        CriticalSection lock;
+        FreeBlock* entry = static_cast<FreeBlock*>(block);
+        entry->next = free_;
+        free_ = entry;
+        used_--;
+    }
+
+    //=========================================================================
+    // Size classes
+    //=========================================================================
+
+    void* allocate(size_t size) {
+        for (uint32_t i = 0; i < POOL_COUNT; i++) {
+            BlockPool& pool = pools[i];
+            if (size > pool.getBlockSize()) {
+                continue;
+            }
+            void* block = pool.allocate();
+            if (block) {
+                return block;
+            }
+            // Exhausted: spill into the next larger class
+        }
+        return nullptr;
+    }
+
+    void release(void* block) {
+        for (uint32_t i = 0; i < POOL_COUNT; i++) {
+            if (pools[i].owns(block)) {
+                pools[i].release(block);
+                return;
+            }
+        }
+        Error_Handler();            // Not from a pool: heap corruption or double ownership
+    }
+
+    size_t getAllocationSize(const void* block) {
+        for (uint32_t i = 0; i < POOL_COUNT; i++) {
+            if (pools[i].owns(block)) {
+                return pools[i].getBlockSize();
+            }
+        }
+        return 0;
+    }
+
+    uint32_t getPoolCount() {
+        return POOL_COUNT;
+    }
+
+    const BlockPool& getPool(uint32_t index) {
+        return pools[(index < POOL_COUNT) ? index : (POOL_COUNT - 1U)];
+    }
+
+} // namespace MEMORY
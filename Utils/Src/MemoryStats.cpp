@@ -0,0 +1,164 @@
+/**
+ * @file    MemoryStats.cpp
+ * @brief   Dynamic memory telemetry for RAM budgeting
+ */
+
+#include "MemoryStats.h"
+#include "MemoryPool.h"
+#include "Arena.h"
+#include "Log.h"
+#include "CriticalSection.h"
+
+extern "C" {
+    // sysmem.c
+    uintptr_t SYSMEM_GetHeapStart(void);
+    uintptr_t SYSMEM_GetHeapBreak(void);
+    uintptr_t SYSMEM_GetHeapLimit(void);
+    uint32_t SYSMEM_GetSbrkFailures(void);
+}
+
+namespace MEMORY
+{
+    static_assert(MEMORY_HISTOGRAM_BINS >= 2U && MEMORY_HISTOGRAM_BINS <= 32U,
+                  "MEMORY_HISTOGRAM_BINS must be between 2 and 32");
+
+    static uint32_t liveBytes = 0;
+    static uint32_t peakBytes = 0;
+    static uint32_t allocations = 0;
+    static uint32_t releases = 0;
+    static uint32_t failures = 0;
+    static uint32_t histogram[MEMORY_HISTOGRAM_BINS] = {};
+
+    /**
+     * @brief Histogram bin: ceil(log2(size)), clamped to the last bin
+     */
+    static uint32_t binOf(size_t size) {
+        const uint32_t bin = (size <= 1U) ? 0U : (32U - __CLZ(static_cast<uint32_t>(size - 1U)));
+        return (bin < MEMORY_HISTOGRAM_BINS) ? bin : (MEMORY_HISTOGRAM_BINS - 1U);
+    }
+
+    /**
+     * @brief Bytes reserved for a block: arena slices are rounded to 8, pool blocks are whole
+     */
+    static uint32_t reservedSize(size_t requested, const void* block) {
+        if (getInitArena().owns(block)) {
+            return static_cast<uint32_t>((requested + 7U) & ~static_cast<size_t>(7U));
+        }
+        return static_cast<uint32_t>(getAllocationSize(block));
+    }
+
+    void recordAllocation(size_t requested, const void* block) {
+        const uint32_t reserved = reservedSize(requested, block);
+        CriticalSection lock;
+        liveBytes += reserved;
+        if (liveBytes > peakBytes) {
+            peakBytes = liveBytes;
+        }
+        allocations++;
+        histogram[binOf(requested)]++;
+    }
+
+    void recordFailure(size_t requested) {
+        CriticalSection lock;
+        failures++;
+        histogram[binOf(requested)]++;
+    }
+
+    void recordRelease(const void* block) {
+        if (getInitArena().owns(block)) {
+            return;     // Never reused: stays live
+        }
+        const uint32_t reserved = static_cast<uint32_t>(getAllocationSize(block));
+        CriticalSection lock;
+        liveBytes -= reserved;
+        releases++;
+    }
+
+    /**
+     * @brief Largest block class that still has room (requests spill upward)
+     */
+    static uint32_t largestFreeBlock() {
+        uint32_t largest = 0;
+        for (uint32_t i = 0; i < getPoolCount(); i++) {
+            const BlockPool& pool = getPool(i);
+            if (pool.getUsed() < pool.getBlockCount()) {
+                largest = static_cast<uint32_t>(pool.getBlockSize());
+            }
+        }
+        if (!isFrozen()) {
+            const Arena& arena = getInitArena();
+            const uint32_t remaining = static_cast<uint32_t>(arena.getSize() - arena.getUsed());
+            if (remaining > largest) {
+                largest = remaining;
+            }
+        }
+        return largest;
+    }
+
+    Stats getStats() {
+        Stats stats;
+        {
+            CriticalSection lock;
+            stats.liveBytes = liveBytes;
+            stats.peakBytes = peakBytes;
+            stats.allocations = allocations;
+            stats.releases = releases;
+            stats.failures = failures;
+            for (uint32_t i = 0; i < MEMORY_HISTOGRAM_BINS; i++) {
+                stats.histogram[i] = histogram[i];
+            }
+        }
+        stats.largestFreeBlock = largestFreeBlock();
+        stats.sbrkStart = SYSMEM_GetHeapStart();
+        stats.sbrkBreak = SYSMEM_GetHeapBreak();
+        stats.sbrkLimit = SYSMEM_GetHeapLimit();
+        stats.sbrkFailures = SYSMEM_GetSbrkFailures();
+        return stats;
+    }
+
+    void resetStats() {
+        CriticalSection lock;
+        peakBytes = liveBytes;
+        allocations = 0;
+        releases = 0;
+        failures = 0;
+        for (uint32_t i = 0; i < MEMORY_HISTOGRAM_BINS; i++) {
+            histogram[i] = 0;
+        }
+    }
+
+    void printStats() {
+        const Stats stats = getStats();
+        const Arena& arena = getInitArena();
+
+        LOG_MSG("Memory: %u live, %u peak bytes, %u new, %u delete, %u failed, largest free %u\n",
+                static_cast<unsigned>(stats.liveBytes), static_cast<unsigned>(stats.peakBytes),
+                static_cast<unsigned>(stats.allocations), static_cast<unsigned>(stats.releases),
+                static_cast<unsigned>(stats.failures), static_cast<unsigned>(stats.largestFreeBlock));
+        LOG_MSG("- arena: %u of %u bytes%s\n",
+                static_cast<unsigned>(arena.getUsed()), static_cast<unsigned>(arena.getSize()),
+                isFrozen() ? " (frozen)" : "");
+        for (uint32_t i = 0; i < getPoolCount(); i++) {
+            const BlockPool& pool = getPool(i);
+            LOG_MSG("- pool %u: %u of %u used, peak %u, exhausted %u\n",
+                    static_cast<unsigned>(pool.getBlockSize()), static_cast<unsigned>(pool.getUsed()),
+                    static_cast<unsigned>(pool.getBlockCount()), static_cast<unsigned>(pool.getPeak()),
+                    static_cast<unsigned>(pool.getExhausted()));
+        }
+        for (uint32_t i = 0; i < MEMORY_HISTOGRAM_BINS; i++) {
+            if (stats.histogram[i] == 0) {
+                continue;
+            }
+            if (i + 1U < MEMORY_HISTOGRAM_BINS) {
+                LOG_MSG("- size <= %u: %u\n", static_cast<unsigned>(1UL << i), static_cast<unsigned>(stats.histogram[i]));
+            } else {
+                LOG_MSG("- size > %u: %u\n", static_cast<unsigned>(1UL << (i - 1U)), static_cast<unsigned>(stats.histogram[i]));
+            }
+        }
+        LOG_MSG("- sbrk: %u bytes used, %u to the stack, %u refused\n",
+                static_cast<unsigned>(stats.sbrkBreak - stats.sbrkStart),
+                static_cast<unsigned>(stats.sbrkLimit - stats.sbrkBreak),
+                static_cast<unsigned>(stats.sbrkFailures));
+    }
+
+} // namespace MEMORY
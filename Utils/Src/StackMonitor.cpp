@@ -0,0 +1,70 @@
+/**
+ * @file    StackMonitor.cpp
+ * @brief   Stack painting and high-water measurement
+ */
+
+#include "StackMonitor.h"
+#include "Kernel.h"
+#include "Log.h"
+
+extern "C" {
+    // Linker script symbols
+    extern uint32_t _estack;
+    extern uint32_t _Min_Stack_Size;
+}
+
+namespace STACK
+{
+    volatile uint32_t lowestMsp = 0xFFFFFFFFUL;
+
+    void paint(uint32_t* base, uint32_t words) {
+        for (uint32_t i = 0; i < words; i++) {
+            base[i] = STACK_PAINT_PATTERN;
+        }
+    }
+
+    Usage measure(const uint32_t* base, uint32_t words) {
+        uint32_t untouched = 0;
+        while (untouched < words && base[untouched] == STACK_PAINT_PATTERN) {
+            untouched++;
+        }
+        Usage usage;
+        usage.sizeBytes = words * 4U;
+        usage.peakBytes = (words - untouched) * 4U;
+        return usage;
+    }
+
+    Usage measureMsp() {
+        const uint32_t size = reinterpret_cast<uintptr_t>(&_Min_Stack_Size);
+        const uint32_t* base = reinterpret_cast<const uint32_t*>(reinterpret_cast<uintptr_t>(&_estack) - size);
+        return measure(base, size / 4U);
+    }
+
+    uint32_t getSampledMspPeak() {
+        const uint32_t lowest = lowestMsp;
+        if (lowest == 0xFFFFFFFFUL) {
+            return 0;
+        }
+        return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&_estack)) - lowest;
+    }
+
+    static void printOne(const char* name, const Usage& usage) {
+        LOG_MSG("Stack %s: %u of %u bytes (%u%%)\n", name,
+                static_cast<unsigned>(usage.peakBytes), static_cast<unsigned>(usage.sizeBytes),
+                static_cast<unsigned>(usage.sizeBytes ? (usage.peakBytes * 100U) / usage.sizeBytes : 0U));
+    }
+
+    void printUsage() {
+        printOne("MSP", measureMsp());
+#if (STACK_SAMPLE_ISR == 1)
+        LOG_MSG("Stack MSP on interrupt entry: %u bytes\n", static_cast<unsigned>(getSampledMspPeak()));
+#endif
+        for (const KERNEL::Thread* thread = KERNEL::firstThread(); thread; thread = thread->getNextThread()) {
+            if (thread->getStackBase()) {
+                printOne(thread->getName() ? thread->getName() : "?",
+                         measure(thread->getStackBase(), thread->getStackWords()));
+            }
+        }
+    }
+
+} // namespace STACK
@@ -0,0 +1,108 @@
+/**
+ * @file    SystemTime.cpp
+ * @brief   Monotonic 64-bit time base from the SysTick counter
+ */
+
+#include "SystemTime.h"
+#include "CriticalSection.h"
+
+namespace TIME
+{
+    // SysTick reload value is 24 bits
+    static constexpr uint32_t MAX_PERIOD = SysTick_LOAD_RELOAD_Msk + 1U;
+
+    // Cycles at the last SysTick reload; only accessed with interrupts masked
+    static uint64_t base = 0;
+
+    // Normal SysTick period (1 ms)
+    static uint32_t tickCycles = 0;
+
+    /**
+     * @brief Account a wrap if one happened and return the current time
+     * @note Interrupts masked
+     */
+    static uint64_t sync() {
+        const uint32_t load = SysTick->LOAD;
+        uint32_t value = SysTick->VAL;
+        if (SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) {
+            base += load + 1U;
+            value = SysTick->VAL;       // The counter has reloaded by now
+        }
+        // Without the flag the first read preceded the wrap, so it belongs to this period
+        return base + (load - value);
+    }
+
+    /**
+     * @brief Restart SysTick with a new period from the current time
+     * @note Interrupts masked
+     */
+    static void setPeriod(uint32_t cycles) {
+        const uint64_t now = sync();
+        SysTick->LOAD = cycles - 1U;
+        SysTick->VAL = 0;               // Reloads on the next clock, clears COUNTFLAG
+        base = now;
+    }
+
+    void init() {
+        enableCycleCounter();           // TIME::cycles() for short measurements
+        CriticalSection lock;
+        tickCycles = SysTick->LOAD + 1U;
+        SysTick->VAL = 0;
+        base = 0;
+        SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;
+    }
+
+    void handleTick() {
+        CriticalSection lock;
+        sync();                         // Nothing to do if a reader took the wrap already
+    }
+
+    uint32_t sleep(bool tickless) {
+        CriticalSection lock;
+        const uint64_t start = sync();
+        if (tickless) {
+            setPeriod(MAX_PERIOD);
+        }
+
+        __DSB();
+        __WFI();                        // Wakes on a pending interrupt even while masked
+
+        if (tickless) {
+            setPeriod(tickCycles);
+        }
+        return static_cast<uint32_t>(sync() - start);
+    }
+
+    uint64_t nowCycles() {
+        CriticalSection lock;
+        return sync();
+    }
+
+    uint64_t nowUs() {
+        return nowCycles() / (SystemCoreClock / 1000000U);
+    }
+
+    uint32_t nowMs() {
+        return static_cast<uint32_t>(nowCycles() / (SystemCoreClock / 1000U));
+    }
+
+    void delayUntil(uint64_t deadlineUs) {
+        // Any interrupt ends WFI early; SysTick guarantees a wake-up every millisecond
+        while (nowUs() + 1000U < deadlineUs) {
+            __WFI();
+        }
+        while (nowUs() < deadlineUs) {
+        }
+    }
+
+} // namespace TIME
+
+extern "C" {
+    void TIME_Init(void) {
+        TIME::init();
+    }
+
+    void TIME_HandleSysTick(void) {
+        TIME::handleTick();
+    }
+}